@@ -0,0 +1,57 @@
+#!/usr/bin/env bash
+# Benchmarks the playback of a synthetic simulation with many active obstructions and appends the results of each run
+# to a .csv file, so the per-timestep cost of the obstructions can be compared between revisions.
+#
+# Usage: UE_ROOT=<Engine root> Scripts/ObstructionPlaybackBenchmark.sh [NumObstructions=500] [Report.csv]
+#
+# Run it once on each revision to compare (both have to contain the playback benchmark) and compare the rows of the
+# report, e.g. meanNextTimeStepTime and meanLoadUnloadTimeStepTime in milliseconds.
+
+set -euo pipefail
+
+: "${UE_ROOT:?Set UE_ROOT to the root directory of the Unreal Engine installation}"
+NUM_OBSTRUCTIONS="${1:-500}"
+PROJECT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+REPORT="${2:-$PROJECT_DIR/Saved/PlaybackBenchmark/Obstructions$NUM_OBSTRUCTIONS.csv}"
+PROJECT="$PROJECT_DIR/VRSmokeVis.uproject"
+OUTPUT=/Game/ObstructionBenchmark
+RUN_REPORT="$PROJECT_DIR/Saved/PlaybackBenchmark/ObstructionRun.json"
+
+case "$(uname -s)" in
+	Linux*) PLATFORM=Linux ;;
+	Darwin*) PLATFORM=Mac ;;
+	*) PLATFORM=Win64 ;;
+esac
+EDITOR_CMD="$UE_ROOT/Engine/Binaries/$PLATFORM/UnrealEditor-Cmd"
+EDITOR="$UE_ROOT/Engine/Binaries/$PLATFORM/UnrealEditor"
+
+# Import the synthetic simulation and create all of its textures, so the playback never has to import anything
+"$EDITOR_CMD" "$PROJECT" -run=VRSSImportBenchmark -Synthetic -Obstructions="$NUM_OBSTRUCTIONS" -Slices=0 -Volumes=0 \
+	-Output="$OUTPUT" -CreateTextures -nullrhi -unattended
+
+# Activate all obstructions, play through all timesteps and quit once the playback wraps around
+mkdir -p "$(dirname "$RUN_REPORT")"
+rm -f "$RUN_REPORT"
+"$EDITOR" "$PROJECT" -game -PlaybackBenchmark -Simulation="$OUTPUT/Synthetic.Synthetic" -NoSlices -NoVolumes \
+	-Report="$RUN_REPORT" -Quit -unattended -windowed -ResX=1280 -ResY=720
+if [ ! -f "$RUN_REPORT" ]; then
+	echo "The playback benchmark did not write a report" >&2
+	exit 1
+fi
+
+# Flatten the json object of the run into a row tagged with the revision
+REVISION="$(git -C "$PROJECT_DIR" rev-parse --short HEAD)"
+python3 - "$RUN_REPORT" "$REPORT" "$REVISION" "$NUM_OBSTRUCTIONS" <<'PYTHON'
+import csv, json, os, sys
+run_report, report, revision, num_obstructions = sys.argv[1:]
+with open(run_report, encoding="utf-8-sig") as f:
+    results = json.load(f)
+row = {"revision": revision, "numObstructions": num_obstructions, **results}
+write_header = not os.path.exists(report)
+with open(report, "a", newline="") as f:
+    writer = csv.DictWriter(f, fieldnames=list(row.keys()))
+    if write_header:
+        writer.writeheader()
+    writer.writerow(row)
+print(f"Appended the results of {revision} to {report}")
+PYTHON
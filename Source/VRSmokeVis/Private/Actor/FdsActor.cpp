@@ -1,5 +1,72 @@
 
 #include "Actor/FdsActor.h"
 #include "Assets/FdsDataAsset.h"
+#include "Assets/FdsTimeSeriesAsset.h"
+#include "Util/TextureUtilities.h"
 
 
+#if WITH_EDITOR
+void AFdsActor::BeginPlay()
+{
+	Super::BeginPlay();
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(
+		this, &AFdsActor::OnObjectPropertyChanged);
+}
+
+void AFdsActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFdsActor::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Inactive actors build their descriptor again when they are activated
+	if (Object == DataAsset && !IsHidden()) BuildPlaybackDescriptor();
+}
+#endif
+
+void AFdsActor::StreamTimeSeries(const int NextTimeStep)
+{
+	const UFdsTimeSeriesAsset* TimeSeries = DataAsset->TimeSeries;
+	const int NumTimeSteps = TimeSeries->GetNumTimeSteps();
+	if (TimeSeriesTextures.Num() == 0)
+	{
+		for (int i = 0; i < NumTimeSeriesTextures; ++i)
+		{
+			TimeSeriesTextures.Add(FTextureUtils::CreateTransientTexture(TimeSeries->Dimensions));
+			TimeSeriesTextureTimeSteps.Add(-1);
+		}
+	}
+
+	// The texture of the next timestep becomes the one of the current timestep. All other textures should contain
+	// the following timesteps, only those that don't (e.g. after rewinding) have to be streamed
+	TimeSeriesRingHead = (TimeSeriesRingHead + 1) % NumTimeSeriesTextures;
+	for (int i = 1; i < NumTimeSeriesTextures; ++i)
+	{
+		const int Index = (TimeSeriesRingHead + i) % NumTimeSeriesTextures;
+		const int TimeStep = (NextTimeStep + i - 1) % NumTimeSteps;
+		if (TimeSeriesTextureTimeSteps[Index] == TimeStep) continue;
+		TimeSeriesTextureTimeSteps[Index] = TimeStep;
+
+		TWeakObjectPtr<AFdsActor> WeakThis(this);
+		const FIntVector Dimensions = TimeSeries->Dimensions;
+		TimeSeries->ReadTimeStepAsync(TimeStep, [WeakThis, Index, TimeStep, Dimensions](FStagingBuffer&& Data)
+		{
+			// Data that arrives after the texture has been reused for another timestep is outdated
+			const AFdsActor* This = WeakThis.Get();
+			if (!This || This->TimeSeriesTextureTimeSteps[Index] != TimeStep) return;
+			FTextureUtils::UpdateTextureData(This->TimeSeriesTextures[Index], Dimensions, MoveTemp(Data));
+		});
+	}
+}
+
+UTexture* AFdsActor::GetTimeSeriesTextureT0() const
+{
+	return TimeSeriesTextures[TimeSeriesRingHead];
+}
+
+UTexture* AFdsActor::GetTimeSeriesTextureT1() const
+{
+	return TimeSeriesTextures[(TimeSeriesRingHead + 1) % NumTimeSeriesTextures];
+}
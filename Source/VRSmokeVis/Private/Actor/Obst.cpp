@@ -1,6 +1,7 @@
 #include "Actor/Obst.h"
 
 #include "VRSSConfig.h"
+#include "VRSSStats.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Util/TextureUtilities.h"
 #include "Assets/ObstAsset.h"
@@ -65,62 +66,120 @@ void AObst::BeginPlay()
 	}
 
 	Sim->InitUpdateRate("Obst", ObstDataInfo->Spacings[Orientations[0]].W, ObstDataInfo->Dimensions[Orientations[0]].W);
+}
 
-	for (const int Orientation : Orientations)
+void AObst::InitDataMaterials()
+{
+	if (ObstDataMaterials.Num() > 0 || !ObstDataMaterialBase) return;
+
+	for (const TPair<int, UTexture2D*>& DataTexture : DataTexturesT0)
 	{
-		if (ObstDataMaterialBase)
-		{
-			UMaterialInstanceDynamic* ObstMaterial = UMaterialInstanceDynamic::Create(
-				ObstDataMaterialBase, this, *("Obst Mat Dynamic Inst" + FString::FromInt(Orientation)));
-			ObstDataMaterials.Add(Orientation, ObstMaterial);
-		}
+		const int Orientation = DataTexture.Key;
+		UMaterialInstanceDynamic* ObstMaterial = UMaterialInstanceDynamic::Create(
+			ObstDataMaterialBase, this, *("Obst Mat Dynamic Inst" + FString::FromInt(Orientation)));
+		ObstDataMaterials.Add(Orientation, ObstMaterial);
 
 		if (StaticMeshComponent)
-			StaticMeshComponent->SetMaterialByName(*FString::FromInt(Orientation), ObstDataMaterials[Orientation]);
+			StaticMeshComponent->SetMaterialByName(*FString::FromInt(Orientation), ObstMaterial);
 	}
+
+	// Apply everything that has been set while the materials did not exist yet
+	UpdateQuantityParameters();
+	UpdateAtlasRects();
+	if (ColorMapScaleMax > ColorMapScaleMin)
+		UpdateColorMapScale(ColorMapScaleMin, ColorMapScaleMax);
 }
 
-void AObst::UpdateTexture(const int CurrentTimeStep, const int Orientation)
+void AObst::UpdateTexture(const int CurrentTimeStep)
 {
-	TArray<FAssetData>& ObstTextures = Cast<UObstAsset>(DataAsset)->ObstTextures[ActiveQuantity].ForOrientation[Orientation].Textures;
-	// Load the texture for the next time step to interpolate between the next and current one
-	UTexture2D* NextTexture = Cast<UTexture2D>(ObstTextures[(CurrentTimeStep + 1) % ObstTextures.Num()].GetAsset());
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_UpdateObst);
+	TimePassedPercentage = 0;
 
-	if (!NextTexture)
+	// All faces share the same texture if an atlas is used, so it only has to be looked up once
+	const TArray<FSoftObjectPath>* AtlasTexturePaths = PlaybackDescriptor.AtlasTexturePaths;
+	UTexture2D* NextAtlasTexture = nullptr;
+	if (AtlasTexturePaths)
 	{
-		UE_LOG(LogObst, Error, TEXT("Tried to initialize Obst resources with no data textures!"));
-		return;
+		NextAtlasTexture = Cast<UTexture2D>(
+			(*AtlasTexturePaths)[(CurrentTimeStep + 1) % AtlasTexturePaths->Num()].TryLoad());
 	}
 
-	if (!NextTexture->GetPlatformData() || NextTexture->GetSizeX() == 0 || NextTexture->GetSizeY() == 0)
+	for (const FFdsTextureChannel& Channel : PlaybackDescriptor.Channels)
 	{
-		// Happens in cooking stage where per-platform data isn't initialized. Return.
-		UE_LOG(LogObst, Warning,
-		       TEXT(
-			       "Following is safe to ignore during cooking :\nTried to initialize Obst resources with an unitialized data "
-			       "texture with size 0!\nObst name = %s, Texture name = %s"),
-		       *GetName(), *NextTexture->GetName());
-		return;
+		const int Orientation = Channel.Orientation;
+		// Load the texture for the next time step to interpolate between the next and current one
+		UTexture2D* NextTexture = NextAtlasTexture;
+		if (!AtlasTexturePaths)
+		{
+			NextTexture = Cast<UTexture2D>(
+				Channel.TexturePaths[(CurrentTimeStep + 1) % Channel.TexturePaths.Num()].TryLoad());
+		}
+
+		if (!NextTexture)
+		{
+			UE_LOG(LogObst, Error, TEXT("Tried to initialize Obst resources with no data textures!"));
+			return;
+		}
+
+		if (!NextTexture->GetPlatformData() || NextTexture->GetSizeX() == 0 || NextTexture->GetSizeY() == 0)
+		{
+			// Happens in cooking stage where per-platform data isn't initialized. Return.
+			UE_LOG(LogObst, Warning,
+			       TEXT(
+				       "Following is safe to ignore during cooking :\nTried to initialize Obst resources with an unitialized data "
+				       "texture with size 0!\nObst name = %s, Texture name = %s"),
+			       *GetName(), *NextTexture->GetName());
+			return;
+		}
+
+		DataTexturesT0[Orientation] = DataTexturesT1[Orientation];
+		DataTexturesT1[Orientation] = NextTexture;
+
+		// Update dynamic material instance
+		UMaterialInstanceDynamic* ObstDataMaterial = ObstDataMaterials[Orientation];
+		ObstDataMaterial->SetTextureParameterValue("TextureT0", DataTexturesT0[Orientation]);
+		ObstDataMaterial->SetTextureParameterValue("TextureT1", DataTexturesT1[Orientation]);
+		ObstDataMaterial->SetScalarParameterValue("TimePassedPercentage", TimePassedPercentage);
 	}
+}
 
-	TimePassedPercentage = 0;
-	DataTexturesT0[Orientation] = DataTexturesT1[Orientation];
-	DataTexturesT1[Orientation] = NextTexture;
+void AObst::BuildPlaybackDescriptor()
+{
+	const UObstAsset* ObstAsset = Cast<UObstAsset>(DataAsset);
+	const UBoundaryDataInfo* ObstDataInfo = Cast<UBoundaryDataInfo>(DataAsset->DataInfo);
+	const FFixedQuantityObstTextures& QuantityTextures = ObstAsset->ObstTextures[ActiveQuantity];
 
-	// Update dynamic material instance
-	ObstDataMaterials[Orientation]->SetTextureParameterValue("TextureT0", DataTexturesT0[Orientation]);
-	ObstDataMaterials[Orientation]->SetTextureParameterValue("TextureT1", DataTexturesT1[Orientation]);
-	ObstDataMaterials[Orientation]->SetScalarParameterValue("TimePassedPercentage", TimePassedPercentage);
+	PlaybackDescriptor.AtlasTexturePaths = Sim->GetObstAtlasTexturePaths(ActiveQuantity);
+	PlaybackDescriptor.Channels.Reset();
+	for (const TPair<int, FVector4>& Dimension : ObstDataInfo->Dimensions)
+	{
+		FFdsTextureChannel& Channel = PlaybackDescriptor.Channels.AddDefaulted_GetRef();
+		Channel.Orientation = Dimension.Key;
+		Channel.Dimensions = Dimension.Value;
+		if (PlaybackDescriptor.AtlasTexturePaths)
+			Channel.AtlasRect = ObstAsset->AtlasRects.FindRef(Dimension.Key);
+		else
+			Channel.TexturePaths = QuantityTextures.ForOrientation[Dimension.Key].Textures;
+	}
+	UpdateAtlasRects();
 }
 
-void AObst::UpdateColorMapScale(const float NewMin, const float NewMax) const
+void AObst::UpdateAtlasRects()
 {
-	if (ActiveQuantity.IsEmpty()) return;
+	for (const FFdsTextureChannel& Channel : PlaybackDescriptor.Channels)
+	{
+		if (UMaterialInstanceDynamic** ObstDataMaterial = ObstDataMaterials.Find(Channel.Orientation))
+			(*ObstDataMaterial)->SetVectorParameterValue("AtlasRect", FLinearColor(Channel.AtlasRect));
+	}
+}
 
-	UBoundaryDataInfo* ObstDataInfo = Cast<UBoundaryDataInfo>(DataAsset->DataInfo);
-	
-	TArray<int> Orientations;
-	ObstDataInfo->Dimensions.GetKeys(Orientations);
+void AObst::UpdateColorMapScale(const float NewMin, const float NewMax)
+{
+	ColorMapScaleMin = NewMin;
+	ColorMapScaleMax = NewMax;
+	if (ActiveQuantity.IsEmpty() || ObstDataMaterials.Num() == 0) return;
+
+	const UBoundaryDataInfo* ObstDataInfo = Cast<UBoundaryDataInfo>(DataAsset->DataInfo);
 
 	const float NewRange = NewMax - NewMin;
 	const float NewMinScaled = ObstDataInfo->MinValues[ActiveQuantity] / NewRange + (ObstDataInfo->
@@ -129,10 +188,10 @@ void AObst::UpdateColorMapScale(const float NewMin, const float NewMax) const
 	const float ColorMapRange = (ObstDataInfo->MaxValues[ActiveQuantity] - ObstDataInfo->MinValues[
 		ActiveQuantity]) / NewRange;
 
-	for (const int Orientation : Orientations)
+	for (const TPair<int, UMaterialInstanceDynamic*>& ObstDataMaterial : ObstDataMaterials)
 	{
-		ObstDataMaterials[Orientation]->SetScalarParameterValue("ColorMapMin", NewMinScaled);
-		ObstDataMaterials[Orientation]->SetScalarParameterValue("ColorMapRange", ColorMapRange);
+		ObstDataMaterial.Value->SetScalarParameterValue("ColorMapMin", NewMinScaled);
+		ObstDataMaterial.Value->SetScalarParameterValue("ColorMapRange", ColorMapRange);
 	}
 }
 
@@ -143,8 +202,6 @@ void AObst::SetActiveQuantity(FString GlobalObstQuantity)
 
 	ActiveQuantity = GlobalObstQuantity;
 
-	const UVRSSGameInstanceSubsystem* GI = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>();
-
 	UObstAsset *ObstAsset = Cast<UObstAsset>(DataAsset);
 	UBoundaryDataInfo* ObstDataInfo = Cast<UBoundaryDataInfo>(ObstAsset->DataInfo);
 	ObstAsset->ObstTextures.FindOrAdd(ActiveQuantity, FFixedQuantityObstTextures());
@@ -152,15 +209,28 @@ void AObst::SetActiveQuantity(FString GlobalObstQuantity)
 	TArray<int> Orientations;
 	ObstDataInfo->Dimensions.GetKeys(Orientations);
 
-	const float CutOffValue = (GI->Config->GetObstCutOffValue(ActiveQuantity) - ObstDataInfo->
-		MinValues[ActiveQuantity]) * ObstDataInfo->ScaleFactors[ActiveQuantity] / 255.f;
 	for (const int Orientation : Orientations)
 	{
 		ObstAsset->ObstTextures[ActiveQuantity].ForOrientation.FindOrAdd(Orientation, FFixedFaceObstTextures());
+	}
 
-		ObstDataMaterials[Orientation]->SetScalarParameterValue("CutOffValue", CutOffValue);
+	UpdateQuantityParameters();
+}
+
+void AObst::UpdateQuantityParameters()
+{
+	if (ActiveQuantity.IsEmpty() || ObstDataMaterials.Num() == 0) return;
 
-		ObstDataMaterials[Orientation]->SetTextureParameterValue("ColorMap", GI->Config->GetColorMap(ActiveQuantity));
+	const UVRSSGameInstanceSubsystem* GI = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>();
+	const UBoundaryDataInfo* ObstDataInfo = Cast<UBoundaryDataInfo>(DataAsset->DataInfo);
+
+	const float CutOffValue = (GI->Config->GetObstCutOffValue(ActiveQuantity) - ObstDataInfo->
+		MinValues[ActiveQuantity]) * ObstDataInfo->ScaleFactors[ActiveQuantity] / 255.f;
+	UTexture2D* ColorMap = GI->Config->GetColorMap(ActiveQuantity);
+	for (const TPair<int, UMaterialInstanceDynamic*>& ObstDataMaterial : ObstDataMaterials)
+	{
+		ObstDataMaterial.Value->SetScalarParameterValue("CutOffValue", CutOffValue);
+		ObstDataMaterial.Value->SetTextureParameterValue("ColorMap", ColorMap);
 	}
 }
 
@@ -6,6 +6,9 @@
 #include "Actor/Simulation.h"
 #include "Assets/FdsDataAsset.h"
 #include "Assets/VolumeDataInfo.h"
+#include "Assets/FdsTimeSeriesAsset.h"
+#include "Util/PlaybackWindow.h"
+#include "VRSSStats.h"
 
 DEFINE_LOG_CATEGORY(LogRaymarchVolume)
 
@@ -77,9 +80,26 @@ void ARaymarchVolume::BeginPlay()
 
 void ARaymarchVolume::UpdateVolume(const int CurrentTimeStep)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_UpdateVolume);
 	// Load the texture for the next time step to interpolate between the next and current one
+	const FFdsTextureChannel& Channel = PlaybackDescriptor.Channels[0];
+	const int NextTimeStep = (CurrentTimeStep + 1) % static_cast<int>(Channel.Dimensions.W);
+	if (DataAsset->TimeSeries)
+	{
+		StreamTimeSeries(NextTimeStep);
+
+		TimePassedPercentage = 0;
+		RaymarchMaterial->SetTextureParameterValue("VolumeT0", GetTimeSeriesTextureT0());
+		RaymarchMaterial->SetTextureParameterValue("VolumeT1", GetTimeSeriesTextureT1());
+		RaymarchMaterial->SetScalarParameterValue("TimeStepsPerTexture", 1);
+		RaymarchMaterial->SetScalarParameterValue("SubStepT0", 0);
+		RaymarchMaterial->SetScalarParameterValue("SubStepT1", 0);
+		RaymarchMaterial->SetScalarParameterValue("TimePassedPercentage", TimePassedPercentage);
+		return;
+	}
+
 	UVolumeTexture* NextTexture = Cast<UVolumeTexture>(
-		Cast<UVolumeAsset>(DataAsset)->VolumeTextures[(CurrentTimeStep + 1) % Cast<UVolumeAsset>(DataAsset)->VolumeTextures.Num()].GetAsset());
+		Channel.TexturePaths[FPlaybackWindow::GetTextureIndex(NextTimeStep, Channel.TimeStepsPerTexture)].TryLoad());
 
 	if (!NextTexture)
 	{
@@ -102,6 +122,8 @@ void ARaymarchVolume::UpdateVolume(const int CurrentTimeStep)
 	TimePassedPercentage = 0;
 	DataVolumeTextureT0 = DataVolumeTextureT1;
 	DataVolumeTextureT1 = NextTexture;
+	SubStepT0 = SubStepT1;
+	SubStepT1 = NextTimeStep % Channel.TimeStepsPerTexture;
 
 	// Todo: The TBRaymarch project reported some bugs when not flushing rendering commands here, however it should be
 	// checked again if this is really necessary or if it might decrease performance
@@ -110,9 +132,22 @@ void ARaymarchVolume::UpdateVolume(const int CurrentTimeStep)
 	// Update dynamic material instance
 	RaymarchMaterial->SetTextureParameterValue("VolumeT0", DataVolumeTextureT0);
 	RaymarchMaterial->SetTextureParameterValue("VolumeT1", DataVolumeTextureT1);
+	// The material only samples the part of the texture belonging to the given sub-steps
+	RaymarchMaterial->SetScalarParameterValue("TimeStepsPerTexture", Channel.TimeStepsPerTexture);
+	RaymarchMaterial->SetScalarParameterValue("SubStepT0", SubStepT0);
+	RaymarchMaterial->SetScalarParameterValue("SubStepT1", SubStepT1);
 	RaymarchMaterial->SetScalarParameterValue("TimePassedPercentage", TimePassedPercentage);
 }
 
+void ARaymarchVolume::BuildPlaybackDescriptor()
+{
+	PlaybackDescriptor.Channels.Reset();
+	FFdsTextureChannel& Channel = PlaybackDescriptor.Channels.AddDefaulted_GetRef();
+	Channel.Dimensions = Cast<UVolumeDataInfo>(DataAsset->DataInfo)->Dimensions;
+	Channel.TexturePaths = Cast<UVolumeAsset>(DataAsset)->VolumeTextures;
+	Channel.TimeStepsPerTexture = Cast<UVolumeDataInfo>(DataAsset->DataInfo)->GetTimeStepsPerTexture();
+}
+
 void ARaymarchVolume::Tick(const float DeltaTime)
 {
 	Super::Tick(DeltaTime);
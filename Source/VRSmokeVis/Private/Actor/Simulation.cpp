@@ -1,13 +1,15 @@
 ﻿#include "Actor/Simulation.h"
 
 #include "VRSSConfig.h"
+#include "VRSSStats.h"
 #include "VRSSGameInstanceSubsystem.h"
 #include "Blueprint/UserWidget.h"
+#include "Engine/Texture.h"
 #include "Engine/VolumeTexture.h"
 #include "Kismet/GameplayStatics.h"
+#include "Kismet/KismetSystemLibrary.h"
 #include "Kismet/KismetTextLibrary.h"
 #include "Components/TimelineComponent.h"
-#include "Misc/DefaultValueHelper.h"
 #include "UI/UserInterfaceUserWidget.h"
 #include "UI/TimeUserWidget.h"
 #include "UI/SimControllerUserWidget.h"
@@ -16,8 +18,8 @@
 #include "Actor/Obst.h"
 #include "Actor/RaymarchLight.h"
 #include "Actor/RaymarchVolume.h"
-#include "AssetRegistry/AssetRegistryModule.h"
 #include "Assets/FdsDataAsset.h"
+#include "Assets/FdsTimeSeriesAsset.h"
 #include "Assets/ObstAsset.h"
 #include "Assets/SliceAsset.h"
 #include "Assets/SimulationAsset.h"
@@ -26,141 +28,292 @@
 #include "Components/HorizontalBox.h"
 #include "Components/ScrollBox.h"
 #include "Engine/ObjectLibrary.h"
-#include "Engine/StaticMeshActor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Util/AssetCreationUtilities.h"
 #include "Util/ImportUtilities.h"
+#include "Util/PlaybackWindow.h"
+#include "Util/StagingBufferPool.h"
 
 
 DEFINE_LOG_CATEGORY(LogSimulation)
 
+/** The owner under which the resident atlas textures are tracked, as they are shared by all obstructions */
+static const FName ObstAtlasOwnerName(TEXT("ObstAtlas"));
+
 
 ASimulation::ASimulation()
 {
 	PrimaryActorTick.bCanEverTick = false;
 	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Default Scene Root"));
+
+	// All obstruction cuboids are rendered by this single component, instead of one actor per obstruction
+	ObstGeometryComponent = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(
+		TEXT("Obst Geometry Instances"));
+	ObstGeometryComponent->SetupAttachment(RootComponent);
+	ObstGeometryComponent->SetCollisionEnabled(ECollisionEnabled::Type::QueryOnly);
+	// The index of the obstruction in the manifest of the simulation asset is stored per instance
+	ObstGeometryComponent->NumCustomDataFloats = 1;
 }
 
 void ASimulation::BeginPlay()
 {
 	Super::BeginPlay();
-	
-	// Spawn all obstructions, slices and volumes, but hide them for now
-	InitObstructions();
-	InitSlices();
-	InitVolumes();
 
+	InitStartTime = FPlatformTime::Seconds();
+
+	// Allows benchmarking simulations that are not placed in a level, e.g. one imported by the VRSSImportBenchmark
+	// commandlet
+	FString BenchmarkSimulation;
+	if (FParse::Param(FCommandLine::Get(), TEXT("PlaybackBenchmark")) &&
+		FParse::Value(FCommandLine::Get(), TEXT("Simulation="), BenchmarkSimulation))
+	{
+		SimulationAsset = LoadObject<USimulationAsset>(nullptr, *BenchmarkSimulation);
+		if (!SimulationAsset)
+		{
+			UE_LOG(LogSimulation, Error, TEXT("Could not load the simulation %s to benchmark"), *BenchmarkSimulation);
+			return;
+		}
+	}
+
+	// Load all data assets in the background first, the actors are spawned afterwards in small batches per frame so
+	// that large simulations don't block the game thread
+	TArray<FSoftObjectPath> DataAssetPaths;
+	DataAssetPaths.Append(GetAssetPaths("Obst"));
+	DataAssetPaths.Append(GetAssetPaths("Slice"));
+	DataAssetPaths.Append(GetAssetPaths("Volume"));
+	NumActorsToSpawn = DataAssetPaths.Num();
+
+	if (NumActorsToSpawn == 0)
+	{
+		OnDataAssetsLoaded();
+		return;
+	}
+	// The delegate is executed at once if all data assets are loaded already. The handle is only kept until all actors
+	// have been spawned, which might have happened inside of RequestAsyncLoad already
+	const TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+		DataAssetPaths, FStreamableDelegate::CreateUObject(this, &ASimulation::OnDataAssetsLoaded));
+	if (!bIsInitialized) DataAssetsHandle = Handle;
+}
+
+void ASimulation::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// The staging buffers kept for streaming the time series are not needed anymore once the level is torn down
+	FStagingBufferPool::Get().Trim();
+}
+
+void ASimulation::OnDataAssetsLoaded()
+{
+	UE_LOG(LogSimulation, Log, TEXT("Loaded %d data assets of %s after %.3f seconds"), NumActorsToSpawn, *GetName(),
+	       FPlatformTime::Seconds() - InitStartTime);
+
+	InitActiveObstQuantity();
+	SpawnNextActors();
+}
+
+void ASimulation::SpawnNextActors()
+{
+	const double FrameStartTime = FPlatformTime::Seconds();
+	const TArray<FSoftObjectPath>& ObstPaths = GetAssetPaths("Obst");
+	const TArray<FSoftObjectPath>& SlicePaths = GetAssetPaths("Slice");
+	const TArray<FSoftObjectPath>& VolumePaths = GetAssetPaths("Volume");
+
+	// Spawn obstructions first, then slices and volumes, until either of the per-frame limits has been reached
+	int NumSpawnedThisFrame = 0;
+	while (NumSpawnedActors < NumActorsToSpawn && NumSpawnedThisFrame < MaxActorsSpawnedPerFrame)
+	{
+		// At least one actor is spawned each frame, so spawning always finishes, even with a tiny budget
+		if (NumSpawnedThisFrame > 0 && (FPlatformTime::Seconds() - FrameStartTime) * 1000 > SpawnFrameBudgetMs) break;
+
+		if (const int SliceIndex = NumSpawnedActors - ObstPaths.Num(); SliceIndex < 0)
+			InitObst(ObstPaths[NumSpawnedActors]);
+		else if (SliceIndex < SlicePaths.Num())
+			InitSlice(SlicePaths[SliceIndex]);
+		else
+			InitVolume(VolumePaths[SliceIndex - SlicePaths.Num()]);
+
+		++NumSpawnedActors;
+		++NumSpawnedThisFrame;
+	}
+
+	if (NumSpawnedActors < NumActorsToSpawn)
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &ASimulation::SpawnNextActors);
+		return;
+	}
+
+	// All data assets are referenced by the actors now
+	DataAssetsHandle.Reset();
+	bIsInitialized = true;
+	BuildQuantityRanges();
 	GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->RegisterSimulation(this);
+
+	UE_LOG(LogSimulation, Log, TEXT("Initialized %s with %d obstructions, %d slices and %d volumes in %.3f seconds"),
+	       *GetName(), Obstructions.Num(), Slices.Num(), Volumes.Num(), FPlatformTime::Seconds() - InitStartTime);
+	SimulationInitializedEvent.Broadcast(this);
+
+	// Allows benchmarking the playback without any user interaction, e.g. in nightly runs
+	if (FParse::Param(FCommandLine::Get(), TEXT("PlaybackBenchmark")))
+		StartPlaybackBenchmark(FPlaybackBenchmarkSettings::FromCommandLine(FCommandLine::Get()));
 }
 
-void ASimulation::InitObstructions()
+float ASimulation::GetInitProgress() const
 {
-	if (!SimulationAsset->AssetDirectories.Contains("Obst")) return;
-	
-	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(UObstAsset::StaticClass(), false, GIsEditor);
-	ObjectLibrary->AddToRoot();
-	ObjectLibrary->LoadAssetDataFromPath(SimulationAsset->AssetDirectories["Obst"]);
-	ObjectLibrary->GetAssetDataList(SimulationAsset->Obstructions);
+	if (bIsInitialized) return 1;
 
-	if (SimulationAsset->Obstructions.Num() == 0) return;
+	// Loading the data assets and spawning the actors are weighted equally
+	const float LoadingProgress = DataAssetsHandle.IsValid() ? DataAssetsHandle->GetLoadingProgress() : 1;
+	const float SpawningProgress = NumActorsToSpawn > 0 ? static_cast<float>(NumSpawnedActors) / NumActorsToSpawn : 1;
+	return (LoadingProgress + SpawningProgress) / 2;
+}
 
-	// Set some default obst quantity as active
+bool ASimulation::IsInitialized() const
+{
+	return bIsInitialized;
+}
+
+void ASimulation::InitActiveObstQuantity()
+{
 	const UVRSSGameInstanceSubsystem* GI = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>();
+	ObstQuantity = GI->Config->GetActiveObstQuantity();
+	const TArray<FSoftObjectPath>& ObstPaths = GetAssetPaths("Obst");
+	if (ObstPaths.Num() == 0) return;
+
+	// Set some default obst quantity as active
 	TArray<FString> ObstQuantities;
-	const UObstAsset* RandomObstAsset = Cast<UObstAsset>(
-		StreamableManager.LoadSynchronous(SimulationAsset->Obstructions[0].ToSoftObjectPath()));
+	const UObstAsset* RandomObstAsset = Cast<UObstAsset>(ObstPaths[0].ResolveObject());
 	Cast<UBoundaryDataInfo>(RandomObstAsset->DataInfo)->ScaleFactors.GetKeys(ObstQuantities);
 
 	if (!ObstQuantities.Contains(GI->Config->GetActiveObstQuantity()))
 	{
 		GI->Config->SetActiveObstQuantity(ObstQuantities[0]);
+		ObstQuantity = ObstQuantities[0];
 	}
+}
 
-	const FString& ActiveObstQuantity = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->Config->
-	                                                       GetActiveObstQuantity();
-
+void ASimulation::InitObst(const FSoftObjectPath& ObstPath)
+{
 	const FTransform ZeroTransform;
-	for (FAssetData& ObstAsset : SimulationAsset->Obstructions)
-	{
-		AObst* NewObst = GetWorld()->SpawnActorDeferred<AObst>(ObstClass, ZeroTransform, this);
-		Obstructions.Add(NewObst);
-		NewObst->DataAsset = Cast<UObstAsset>(StreamableManager.LoadSynchronous(ObstAsset.ToSoftObjectPath()));
+	AObst* NewObst = GetWorld()->SpawnActorDeferred<AObst>(ObstClass, ZeroTransform, this);
+	Obstructions.Add(NewObst);
+	// The data asset has already been loaded asynchronously at this point
+	NewObst->DataAsset = Cast<UObstAsset>(ObstPath.ResolveObject());
+	// Assets imported before the texture path tables existed get them generated once
+	if (Cast<UObstAsset>(NewObst->DataAsset)->ObstTextures.Num() == 0)
+		FAssetCreationUtils::CreateTexturePathTables(NewObst->DataAsset, "Obst");
 #if WITH_EDITOR
-		NewObst->SetActorLabel(NewObst->DataAsset->DataInfo->ImportName);
+	NewObst->SetActorLabel(NewObst->DataAsset->DataInfo->ImportName);
 #endif
-		NewObst->SetActorHiddenInGame(true);
-		NewObst->SetActorEnableCollision(false);
-		NewObst->FinishSpawning(ZeroTransform);
-		NewObst->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
-		NewObst->UseSimulationTransform();
-		NewObst->SetActiveQuantity(ActiveObstQuantity);
-	}
+	NewObst->SetActorHiddenInGame(true);
+	NewObst->SetActorEnableCollision(false);
+	NewObst->FinishSpawning(ZeroTransform);
+	// Inactive actors don't need to tick, they will be enabled again on activation
+	NewObst->SetActorTickEnabled(false);
+	NewObst->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
+	NewObst->UseSimulationTransform();
+	NewObst->SetActiveQuantity(ObstQuantity);
 }
 
-void ASimulation::InitSlices()
+void ASimulation::InitSlice(const FSoftObjectPath& SlicePath)
 {
-	if (!SimulationAsset->AssetDirectories.Contains("Slice")) return;
-	
-	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(USliceAsset::StaticClass(), false, GIsEditor);
-	ObjectLibrary->AddToRoot();
-	ObjectLibrary->LoadAssetDataFromPath(SimulationAsset->AssetDirectories["Slice"]);
-	ObjectLibrary->GetAssetDataList(SimulationAsset->Slices);
-
 	const FTransform ZeroTransform;
-	for (FAssetData& SliceAsset : SimulationAsset->Slices)
-	{
-		ASlice* NewSlice = GetWorld()->SpawnActorDeferred<ASlice>(SliceClass, ZeroTransform, this);
-		Slices.Add(NewSlice);
-		NewSlice->DataAsset = Cast<USliceAsset>(StreamableManager.LoadSynchronous(SliceAsset.ToSoftObjectPath()));
+	ASlice* NewSlice = GetWorld()->SpawnActorDeferred<ASlice>(SliceClass, ZeroTransform, this);
+	Slices.Add(NewSlice);
+	NewSlice->DataAsset = Cast<USliceAsset>(SlicePath.ResolveObject());
+	// Assets imported before the texture path tables existed get them generated once
+	if (!NewSlice->DataAsset->TimeSeries && Cast<USliceAsset>(NewSlice->DataAsset)->SliceTextures.Num() == 0)
+		FAssetCreationUtils::CreateTexturePathTables(NewSlice->DataAsset, "Slice");
 #if WITH_EDITOR
-		NewSlice->SetActorLabel(NewSlice->DataAsset->DataInfo->ImportName);
+	NewSlice->SetActorLabel(NewSlice->DataAsset->DataInfo->ImportName);
 #endif
-		NewSlice->SetActorHiddenInGame(true);
-		NewSlice->SetActorEnableCollision(false);
-		NewSlice->FinishSpawning(ZeroTransform);
-		NewSlice->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
-		NewSlice->UseSimulationTransform();
-	}
+	NewSlice->SetActorHiddenInGame(true);
+	NewSlice->SetActorEnableCollision(false);
+	NewSlice->FinishSpawning(ZeroTransform);
+	// Inactive actors don't need to tick, they will be enabled again on activation
+	NewSlice->SetActorTickEnabled(false);
+	NewSlice->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
+	NewSlice->UseSimulationTransform();
 }
 
-void ASimulation::InitVolumes()
+void ASimulation::InitVolume(const FSoftObjectPath& VolumePath)
 {
-	if (!SimulationAsset->AssetDirectories.Contains("Volume")) return;
-	
-	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(UVolumeAsset::StaticClass(), false, GIsEditor);
-	ObjectLibrary->AddToRoot();
-	ObjectLibrary->LoadAssetDataFromPath(SimulationAsset->AssetDirectories["Volume"]);
-	ObjectLibrary->GetAssetDataList(SimulationAsset->Volumes);
-
 	const FTransform ZeroTransform;
-	for (FAssetData& VolumeAsset : SimulationAsset->Volumes)
-	{
-		ARaymarchVolume* NewVolume = GetWorld()->SpawnActorDeferred<ARaymarchVolume>(VolumeClass, ZeroTransform, this);
-		Volumes.Add(NewVolume);
-		NewVolume->DataAsset = Cast<UVolumeAsset>(StreamableManager.LoadSynchronous(VolumeAsset.ToSoftObjectPath()));
+	ARaymarchVolume* NewVolume = GetWorld()->SpawnActorDeferred<ARaymarchVolume>(VolumeClass, ZeroTransform, this);
+	Volumes.Add(NewVolume);
+	NewVolume->DataAsset = Cast<UVolumeAsset>(VolumePath.ResolveObject());
+	// Assets imported before the texture path tables existed get them generated once
+	if (!NewVolume->DataAsset->TimeSeries && Cast<UVolumeAsset>(NewVolume->DataAsset)->VolumeTextures.Num() == 0)
+		FAssetCreationUtils::CreateTexturePathTables(NewVolume->DataAsset, "Volume");
 #if WITH_EDITOR
-		NewVolume->SetActorLabel(NewVolume->DataAsset->DataInfo->ImportName);
+	NewVolume->SetActorLabel(NewVolume->DataAsset->DataInfo->ImportName);
 #endif
-		NewVolume->SetActorHiddenInGame(true);
-		NewVolume->SetActorEnableCollision(false);
-		NewVolume->FinishSpawning(ZeroTransform);
-		NewVolume->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
-		NewVolume->UseSimulationTransform();
+	NewVolume->SetActorHiddenInGame(true);
+	NewVolume->SetActorEnableCollision(false);
+	NewVolume->FinishSpawning(ZeroTransform);
+	// Inactive actors don't need to tick, they will be enabled again on activation
+	NewVolume->SetActorTickEnabled(false);
+	NewVolume->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
+	NewVolume->UseSimulationTransform();
+}
+
+const TArray<FSoftObjectPath>* ASimulation::GetObstAtlasTexturePaths(const FString& Quantity) const
+{
+	const FObstAtlasTextures* AtlasTextures = SimulationAsset->ObstAtlasTextures.Find(Quantity);
+	return AtlasTextures && AtlasTextures->Textures.Num() > 0 ? &AtlasTextures->Textures : nullptr;
+}
+
+const TArray<FSoftObjectPath>& ASimulation::GetAssetPaths(const FString& Type)
+{
+	TArray<FSoftObjectPath>* AssetPaths = &SimulationAsset->Volumes;
+	UClass* AssetClass = UVolumeAsset::StaticClass();
+	if (Type == "Obst")
+	{
+		AssetPaths = &SimulationAsset->Obstructions;
+		AssetClass = UObstAsset::StaticClass();
+	}
+	else if (Type == "Slice")
+	{
+		AssetPaths = &SimulationAsset->Slices;
+		AssetClass = USliceAsset::StaticClass();
+	}
+
+	// Simulations imported before the manifest existed have to scan the asset directory once
+	if (AssetPaths->Num() == 0 && SimulationAsset->AssetDirectories.Contains(Type))
+	{
+		UE_LOG(LogSimulation, Log, TEXT("No %s manifest found for %s, scanning %s instead"), *Type,
+		       *SimulationAsset->GetName(), *SimulationAsset->AssetDirectories[Type]);
+
+		// The library is only used in here, so it is not added to the root set and can be garbage collected afterwards
+		TArray<FAssetData> AssetDataList;
+		UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(AssetClass, false, GIsEditor);
+		ObjectLibrary->LoadAssetDataFromPath(SimulationAsset->AssetDirectories[Type]);
+		ObjectLibrary->GetAssetDataList(AssetDataList);
+		for (const FAssetData& AssetData : AssetDataList)
+		{
+			AssetPaths->Add(AssetData.ToSoftObjectPath());
+		}
 	}
+	return *AssetPaths;
 }
 
 void ASimulation::SpawnSimulationGeometry()
 {
-	if (!SimulationAsset->AssetDirectories.Contains("Obst")) return;
-	
-	TArray<FAssetData> Geometries;
-	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(UDataAsset::StaticClass(), false, GIsEditor);
-	ObjectLibrary->AddToRoot();
-	ObjectLibrary->LoadAssetDataFromPath(SimulationAsset->AssetDirectories["Obst"]);
-	ObjectLibrary->GetAssetDataList(Geometries);
+	const TArray<FSoftObjectPath>& ObstPaths = GetAssetPaths("Obst");
 
-	for (FAssetData& ObstAssetData : Geometries)
+	ObstGeometryComponent->ClearInstances();
+	ObstGeometryComponent->SetStaticMesh(CubeStaticMesh);
+	for (int i = -3; i <= 3; ++i)
+		if (i != 0)
+			ObstGeometryComponent->SetMaterialByName(*FString::FromInt(i), CubeDefaultMaterial);
+
+	TArray<FTransform> InstanceTransforms;
+	InstanceTransforms.Reserve(ObstPaths.Num());
+	for (const FSoftObjectPath& ObstPath : ObstPaths)
 	{
-		UObstAsset* ObstAsset = Cast<UObstAsset>(StreamableManager.LoadSynchronous(ObstAssetData.ToSoftObjectPath()));
+		const UObstAsset* ObstAsset = Cast<UObstAsset>(StreamableManager.LoadSynchronous(ObstPath));
 
 		const FVector ObstScale = FVector(ObstAsset->BoundingBox[1] - ObstAsset->BoundingBox[0],
 										  ObstAsset->BoundingBox[3] - ObstAsset->BoundingBox[2],
@@ -170,38 +323,28 @@ void ASimulation::SpawnSimulationGeometry()
 		const FVector Adjustment = FVector(ObstScale.X, ObstScale.Y, 0);
 		const FVector ObstLocation = FVector(ObstAsset->BoundingBox[0], ObstAsset->BoundingBox[2],
 											 ObstAsset->BoundingBox[4]) + Adjustment / 2;
-		FTransform Transform = FTransform(ObstLocation * 100);
-		
-		AStaticMeshActor* ObstCuboid = GetWorld()->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform);
-#if WITH_EDITOR
-		ObstCuboid->SetActorLabel(ObstAsset->DataInfo->ImportName + "-Geometry");
-#endif
-		ObstCuboid->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
-		ObstCuboid->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
-		ObstCuboid->GetStaticMeshComponent()->SetStaticMesh(CubeStaticMesh);
-		for (int i = -3; i <= 3; ++i)
-			if (i != 0)
-				ObstCuboid->GetStaticMeshComponent()->SetMaterialByName(*FString::FromInt(i), CubeDefaultMaterial);
-
-		ObstCuboid->SetActorScale3D(FVector{1, 1, 1});
-		ObstCuboid->GetStaticMeshComponent()->SetRelativeLocation(FVector{0, 0, 0});
-
-		ObstCuboid->GetStaticMeshComponent()->SetRelativeScale3D(ObstScale);
-		ObstCuboid->SetActorRelativeLocation(ObstLocation * 100);
-		ObstCuboid->SetMobility(EComponentMobility::Static);
-		ObstCuboid->GetStaticMeshComponent()->SetMobility(EComponentMobility::Static);
-		
-		ObstCuboid->FinishSpawning(Transform);
+		InstanceTransforms.Emplace(FRotator::ZeroRotator, ObstLocation * 100, ObstScale);
 	}
+	ObstGeometryComponent->AddInstances(InstanceTransforms, false);
+
+	// Store the index of the obstruction, so that materials are able to address the boundary data per instance
+	for (int i = 0; i < InstanceTransforms.Num(); ++i)
+		ObstGeometryComponent->SetCustomDataValue(i, 0, i, i == InstanceTransforms.Num() - 1);
+
+	SET_DWORD_STAT(STAT_VRSS_ObstGeometryInstances, GetNumObstGeometryInstances());
+	UE_LOG(LogSimulation, Log, TEXT("Rendering %d obstruction cuboids of %s with a single instanced mesh component"),
+	       GetNumObstGeometryInstances(), *GetName());
 }
 
-void ASimulation::UpdateColorMaps(const TMap<FString, float>& Mins, const TMap<FString, float>& Maxs)
+int ASimulation::GetNumObstGeometryInstances() const
 {
-	const FString& ActiveObstQuantity = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->Config->
-	                                                       GetActiveObstQuantity();
+	return ObstGeometryComponent->GetInstanceCount();
+}
 
-	for (const AObst* Obst : Obstructions)
-		Obst->UpdateColorMapScale(Mins[ActiveObstQuantity], Maxs[ActiveObstQuantity]);
+void ASimulation::UpdateColorMaps(const TMap<FString, float>& Mins, const TMap<FString, float>& Maxs)
+{
+	for (AObst* Obst : Obstructions)
+		Obst->UpdateColorMapScale(Mins[ObstQuantity], Maxs[ObstQuantity]);
 
 	for (const ASlice* Slice : Slices)
 		Slice->UpdateColorMapScale(Mins[Cast<USliceDataInfo>(Slice->DataAsset->DataInfo)->Quantity],
@@ -236,57 +379,72 @@ void ASimulation::CheckObstActivations()
 
 void ASimulation::ActivateObst(AObst* Obst)
 {
-	const FString& ActiveObstQuantity = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->Config->
-	                                                       GetActiveObstQuantity();
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Activate);
+	// Remove the existing update event delegate before assigning a new one
+	if (const FDelegateHandle* OldHandle = ObstUpdateDataEventDelegateHandles.Find(Obst->GetName()))
+		UpdateDataEvents["Obst"].Remove(*OldHandle);
 
-	TArray<int> Orientations;
-	UBoundaryDataInfo *ObstDataInfo = Cast<UBoundaryDataInfo>(Obst->DataAsset->DataInfo);
-	ObstDataInfo->Dimensions.GetKeys(Orientations);
-	for (const int Orientation : Orientations)
+	if (const TArray<FSoftObjectPath>* AtlasTexturePaths = GetObstAtlasTexturePaths(ObstQuantity))
 	{
-		ObstUpdateDataEventDelegateHandles.FindOrAdd(Obst->GetName(), TMap<int, FDelegateHandle>());
-		// Remove the existing update event delegate before assigning a new one
-		if (ObstUpdateDataEventDelegateHandles[Obst->GetName()].Contains(Orientation))
-			UpdateDataEvents["Obst"].Remove(ObstUpdateDataEventDelegateHandles[Obst->GetName()][Orientation]);
-
-		// Registering the automatic async texture loading each timestep
-		if (!RegisterTextureLoad("Obst", Obst,
-		                         ObstDataInfo->TextureDirs[ActiveObstQuantity].FaceDirs[Orientation],
-		                         Cast<UObstAsset>(Obst->DataAsset)->ObstTextures[ActiveObstQuantity].ForOrientation[Orientation].Textures,
-		                         ObstDataInfo->Dimensions[Orientation].W))
+		// All faces are part of the atlas textures shared by all obstructions
+		if (!RegisterTextureLoad("Obst", Obst, *AtlasTexturePaths, AtlasTexturePaths->Num(), 1, true))
 			return;
-		FDelegateHandle Handle = UpdateDataEvents["Obst"].AddUObject(Obst, &AObst::UpdateTexture, Orientation);
-		if (ObstUpdateDataEventDelegateHandles[Obst->GetName()].Contains(Orientation))
-			ObstUpdateDataEventDelegateHandles[Obst->GetName()][Orientation] = Handle;
-		else
-			ObstUpdateDataEventDelegateHandles[Obst->GetName()].Add(Orientation, Handle);
 	}
-
-	for (const int Orientation : Orientations)
+	else
 	{
-		// Initialize resources for timestep t=-1 and t=0 (for time interpolation)
-		Obst->UpdateTexture(CurrentTimeSteps["Obst"] - 1, Orientation);
-		Obst->UpdateTexture(CurrentTimeSteps["Obst"], Orientation);
+		UBoundaryDataInfo* ObstDataInfo = Cast<UBoundaryDataInfo>(Obst->DataAsset->DataInfo);
+		FFixedQuantityObstTextures& QuantityTextures = Cast<UObstAsset>(Obst->DataAsset)->ObstTextures[ObstQuantity];
+		for (const TPair<int, FVector4>& Dimension : ObstDataInfo->Dimensions)
+		{
+			// Registering the automatic async texture loading each timestep
+			if (!RegisterTextureLoad("Obst", Obst, QuantityTextures.ForOrientation[Dimension.Key].Textures,
+			                         Dimension.Value.W))
+				return;
+		}
 	}
+	Obst->BuildPlaybackDescriptor();
+	Obst->InitDataMaterials();
+
+	const FDelegateHandle Handle = UpdateDataEvents["Obst"].AddUObject(Obst, &AObst::UpdateTexture);
+	ObstUpdateDataEventDelegateHandles.Add(Obst->GetName(), Handle);
+
+	// Initialize resources for timestep t=-1 and t=0 (for time interpolation)
+	Obst->UpdateTexture(CurrentTimeSteps["Obst"] - 1);
+	Obst->UpdateTexture(CurrentTimeSteps["Obst"]);
 
 	// Show visible components
 	Obst->SetActorHiddenInGame(false);
 	// Activate collision components
 	Obst->SetActorEnableCollision(true);
+	Obst->SetActorTickEnabled(!bIsPaused);
+	if (!ActiveObstructions.Contains(Obst))
+	{
+		// All obstructions show the same quantity, so it is only counted once per simulation
+		if (ActiveObstructions.Num() == 0)
+			GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->AddActiveQuantity(ObstQuantity);
+		ActiveObstructions.Add(Obst);
+	}
 }
 
 void ASimulation::DeactivateObst(AObst* Obst)
 {
-	// Remove the existing update event delegates
-	TArray<int> Orientations;
-	Cast<UBoundaryDataInfo>(Obst->DataAsset->DataInfo)->Dimensions.GetKeys(Orientations);
-	for (const int Orientation : Orientations)
-		UpdateDataEvents["Obst"].Remove(ObstUpdateDataEventDelegateHandles[Obst->GetName()][Orientation]);
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Deactivate);
+	// Remove the existing update event delegate
+	UpdateDataEvents["Obst"].Remove(ObstUpdateDataEventDelegateHandles[Obst->GetName()]);
 
 	// Hides visible components
 	Obst->SetActorHiddenInGame(true);
 	// Disables collision components
 	Obst->SetActorEnableCollision(false);
+	Obst->SetActorTickEnabled(false);
+	// The textures of the window are only streamed for active actors, so they would stay loaded otherwise
+	ReleaseResidentTextures(TEXT("Obst"), Obst->GetFName());
+	if (ActiveObstructions.RemoveSingleSwap(Obst) > 0 && ActiveObstructions.Num() == 0)
+	{
+		GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->RemoveActiveQuantity(ObstQuantity);
+		// The atlas textures are shared by all obstructions, so they can only be released once none is active anymore
+		ReleaseResidentTextures(TEXT("Obst"), ObstAtlasOwnerName);
+	}
 }
 
 void ASimulation::CheckSliceActivations()
@@ -317,13 +475,20 @@ void ASimulation::CheckSliceActivations()
 
 void ASimulation::ActivateSlice(ASlice* Slice)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Activate);
 	// Remove the existing update event delegate before assigning a new one
 	if (SliceUpdateDataEventDelegateHandles.Contains(Slice->GetName()))
 		UpdateDataEvents["Slice"].Remove(SliceUpdateDataEventDelegateHandles[Slice->GetName()]);
 	// Registering the automatic async texture loading each timestep
-	if (!RegisterTextureLoad("Slice", Slice, Cast<USliceDataInfo>(Slice->DataAsset->DataInfo)->TextureDir, Cast<USliceAsset>(Slice->DataAsset)->SliceTextures,
-	                         Cast<USliceDataInfo>(Slice->DataAsset->DataInfo)->Dimensions.W))
+	const USliceDataInfo* SliceDataInfo = Cast<USliceDataInfo>(Slice->DataAsset->DataInfo);
+	if (Slice->DataAsset->TimeSeries)
+	{
+		if (!RegisterTimeSeries(Slice)) return;
+	}
+	else if (!RegisterTextureLoad("Slice", Slice, Cast<USliceAsset>(Slice->DataAsset)->SliceTextures,
+	                         SliceDataInfo->GetNumTimeSteps(), FMath::Max(1, SliceDataInfo->TimeStepsPerTexture)))
 		return;
+	Slice->BuildPlaybackDescriptor();
 	FDelegateHandle Handle = UpdateDataEvents["Slice"].AddUObject(Slice, &ASlice::UpdateTexture);
 	if (SliceUpdateDataEventDelegateHandles.Contains(Slice->GetName()))
 		SliceUpdateDataEventDelegateHandles[Slice->GetName()] = Handle;
@@ -338,10 +503,19 @@ void ASimulation::ActivateSlice(ASlice* Slice)
 	Slice->SetActorHiddenInGame(false);
 	// Activate collision components
 	Slice->SetActorEnableCollision(true);
+	Slice->SetActorTickEnabled(!bIsPaused);
+	if (!ActiveSlices.Contains(Slice))
+	{
+		const FString& Quantity = Cast<USliceDataInfo>(Slice->DataAsset->DataInfo)->Quantity;
+		++ActiveSliceQuantities.FindOrAdd(Quantity);
+		GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->AddActiveQuantity(Quantity);
+		ActiveSlices.Add(Slice);
+	}
 }
 
 void ASimulation::DeactivateSlice(ASlice* Slice)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Deactivate);
 	// Remove the existing update event delegate 
 	UpdateDataEvents["Slice"].Remove(SliceUpdateDataEventDelegateHandles[Slice->GetName()]);
 
@@ -349,6 +523,14 @@ void ASimulation::DeactivateSlice(ASlice* Slice)
 	Slice->SetActorHiddenInGame(true);
 	// Disables collision components
 	Slice->SetActorEnableCollision(false);
+	Slice->SetActorTickEnabled(false);
+	ReleaseResidentTextures(TEXT("Slice"), Slice->GetFName());
+	if (ActiveSlices.RemoveSingleSwap(Slice) > 0)
+	{
+		const FString& Quantity = Cast<USliceDataInfo>(Slice->DataAsset->DataInfo)->Quantity;
+		if (--ActiveSliceQuantities[Quantity] == 0) ActiveSliceQuantities.Remove(Quantity);
+		GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->RemoveActiveQuantity(Quantity);
+	}
 }
 
 void ASimulation::CheckVolumeActivations()
@@ -380,13 +562,20 @@ void ASimulation::CheckVolumeActivations()
 
 void ASimulation::ActivateVolume(ARaymarchVolume* Volume)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Activate);
 	// Remove the existing update event delegate before assigning a new one
 	if (VolumeUpdateDataEventDelegateHandles.Contains(Volume->GetName()))
 		UpdateDataEvents["Volume"].Remove(VolumeUpdateDataEventDelegateHandles[Volume->GetName()]);
 	// Registering the automatic async texture loading each timestep
-	if (!RegisterTextureLoad("Volume", Volume, Cast<UVolumeDataInfo>(Volume->DataAsset->DataInfo)->TextureDir,
-	                         Cast<UVolumeAsset>(Volume->DataAsset)->VolumeTextures, Cast<UVolumeDataInfo>(Volume->DataAsset->DataInfo)->Dimensions.W))
+	const UVolumeDataInfo* VolumeDataInfo = Cast<UVolumeDataInfo>(Volume->DataAsset->DataInfo);
+	if (Volume->DataAsset->TimeSeries)
+	{
+		if (!RegisterTimeSeries(Volume)) return;
+	}
+	else if (!RegisterTextureLoad("Volume", Volume, Cast<UVolumeAsset>(Volume->DataAsset)->VolumeTextures,
+	                         VolumeDataInfo->GetNumTimeSteps(), VolumeDataInfo->GetTimeStepsPerTexture()))
 		return;
+	Volume->BuildPlaybackDescriptor();
 
 	FDelegateHandle Handle = UpdateDataEvents["Volume"].AddUObject(Volume, &ARaymarchVolume::UpdateVolume);
 	if (VolumeUpdateDataEventDelegateHandles.Contains(Volume->GetName()))
@@ -402,10 +591,13 @@ void ASimulation::ActivateVolume(ARaymarchVolume* Volume)
 	Volume->SetActorHiddenInGame(false);
 	// Activate collision components
 	Volume->SetActorEnableCollision(true);
+	Volume->SetActorTickEnabled(!bIsPaused);
+	ActiveVolumes.AddUnique(Volume);
 }
 
 void ASimulation::DeactivateVolume(ARaymarchVolume* Volume)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Deactivate);
 	// Remove the existing update event delegate
 	UpdateDataEvents["Volume"].Remove(VolumeUpdateDataEventDelegateHandles[Volume->GetName()]);
 
@@ -413,6 +605,9 @@ void ASimulation::DeactivateVolume(ARaymarchVolume* Volume)
 	Volume->SetActorHiddenInGame(true);
 	// Disables collision components
 	Volume->SetActorEnableCollision(false);
+	Volume->SetActorTickEnabled(false);
+	ReleaseResidentTextures(TEXT("Volume"), Volume->GetFName());
+	ActiveVolumes.RemoveSingleSwap(Volume);
 }
 
 void ASimulation::InitUpdateRate(const FString Type, const float UpdateRateSuggestion, const int MaxNumUpdates)
@@ -465,7 +660,7 @@ void ASimulation::FastForwardSimulation(const float Amount)
 {
 	for (TTuple<FString, int>& CurrentTimeStep : CurrentTimeSteps)
 	{
-		CurrentTimeStep.Value += Amount - 1;
+		CurrentTimeStep.Value = FPlaybackWindow::GetFastForwardTimeStep(CurrentTimeStep.Value, Amount);
 		NextTimeStep(CurrentTimeStep.Key);
 	}
 
@@ -487,7 +682,7 @@ void ASimulation::RewindSimulation(const float Amount)
 {
 	for (TTuple<FString, int>& CurrentTimeStep : CurrentTimeSteps)
 	{
-		CurrentTimeStep.Value -= FMath::Min<float>(Amount, CurrentTimeStep.Value) + 1;
+		CurrentTimeStep.Value = FPlaybackWindow::GetRewindTimeStep(CurrentTimeStep.Value, Amount);
 		NextTimeStep(CurrentTimeStep.Key);
 	}
 
@@ -509,15 +704,15 @@ void ASimulation::TogglePauseSimulation()
 {
 	bIsPaused = !bIsPaused;
 
-	for (AObst* Obst : Obstructions)
+	for (AObst* Obst : ActiveObstructions)
 	{
 		Obst->SetActorTickEnabled(!bIsPaused);
 	}
-	for (ASlice* Slice : Slices)
+	for (ASlice* Slice : ActiveSlices)
 	{
 		Slice->SetActorTickEnabled(!bIsPaused);
 	}
-	for (ARaymarchVolume* Volume : Volumes)
+	for (ARaymarchVolume* Volume : ActiveVolumes)
 	{
 		Volume->SetActorTickEnabled(!bIsPaused);
 	}
@@ -553,27 +748,23 @@ TArray<FString> ASimulation::GetQuantities(const bool ActiveOnly) const
 {
 	TArray<FString> Quantities = TArray<FString>();
 	if (AnyObstActive() || !ActiveOnly)
-		Quantities.Add(GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->Config->GetActiveObstQuantity());
+		Quantities.Add(ObstQuantity);
 	Quantities.Append(GetSliceQuantities(ActiveOnly));
 	return Quantities;
 }
 
 bool ASimulation::AnyObstActive() const
 {
-	for (const AObst* Obst : Obstructions)
-	{
-		if (!Obst->IsHidden()) return true;
-	}
-	return false;
+	return ActiveObstructions.Num() > 0;
 }
 
 TArray<FString> ASimulation::GetSliceQuantities(const bool ActiveOnly) const
 {
-	TSet<FString> Quantities = TSet<FString>();
-	for (const ASlice* Slice : Slices)
-		if (!ActiveOnly || !Slice->IsHidden())
-			Quantities.Add(Cast<USliceDataInfo>(Slice->DataAsset->DataInfo)->Quantity);
-	return Quantities.Array();
+	if (!ActiveOnly) return SliceQuantities;
+
+	TArray<FString> Quantities;
+	ActiveSliceQuantities.GetKeys(Quantities);
+	return Quantities;
 }
 
 void ASimulation::GetSlicesMaxMinForQuantity(const FString Quantity, float& MinOut, float& MaxOut) const
@@ -605,32 +796,168 @@ void ASimulation::GetObstructionsMaxMinForQuantity(const FString Quantity, float
 
 void ASimulation::ChangeObstQuantity(const FString& NewQuantity)
 {
+	// A switch that is still pending is superseded by the new one
+	if (ObstQuantitySwitchHandle.IsValid())
+	{
+		ObstQuantitySwitchHandle->CancelHandle();
+		ObstQuantitySwitchHandle.Reset();
+	}
+	if (NewQuantity == ObstQuantity) return;
+
+	// The textures are only created when needed for the first time. All quantities and faces of an obstruction are
+	// created at once, so it is enough to check the last texture of one face per obstruction
+	if (!GetObstAtlasTexturePaths(NewQuantity))
+	{
+		for (const AObst* Obst : ActiveObstructions)
+		{
+			const FFixedQuantityObstTextures* QuantityTextures = Cast<UObstAsset>(Obst->DataAsset)->ObstTextures.Find(
+				NewQuantity);
+			if (!QuantityTextures) continue;
+			for (const TPair<int, FFixedFaceObstTextures>& FaceTextures : QuantityTextures->ForOrientation)
+			{
+				if (FaceTextures.Value.Textures.Num() > 0 && !FPackageName::DoesPackageExist(
+					FaceTextures.Value.Textures.Last().GetLongPackageName()))
+					FAssetCreationUtils::LoadTextures(Obst->DataAsset->DataInfo, "Obst");
+				break;
+			}
+		}
+	}
+
+	// Prefetch the textures of the new quantity the active obstructions need around the current timestep with a
+	// single request. The obstructions keep showing the old quantity until all of them have been loaded
+	TArray<FSoftObjectPath> TexturePaths;
+	ForEachObstWindowTexture(NewQuantity, [&TexturePaths](const FSoftObjectPath& TexturePath, const AObst*)
+	{
+		TexturePaths.Add(TexturePath);
+	});
+	if (TexturePaths.Num() == 0)
+	{
+		SwapObstQuantity(NewQuantity);
+		return;
+	}
+
+	// The delegate is executed at once if all textures are loaded already, the handle is only kept while loading
+	const TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+		TexturePaths, FStreamableDelegate::CreateUObject(this, &ASimulation::SwapObstQuantity, NewQuantity));
+	if (Handle.IsValid() && !Handle->HasLoadCompleted()) ObstQuantitySwitchHandle = Handle;
+}
+
+void ASimulation::SwapObstQuantity(const FString NewQuantity)
+{
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Activate);
+	ObstQuantitySwitchHandle.Reset();
+
+	// Release the textures of the old quantity, all obstruction textures that are still resident belong to it
+	ReleaseResidentTextures(TEXT("Obst"));
+
+	UVRSSGameInstanceSubsystem* GI = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>();
+	if (AnyObstActive())
+	{
+		GI->RemoveActiveQuantity(ObstQuantity);
+		GI->AddActiveQuantity(NewQuantity);
+	}
+	ObstQuantity = NewQuantity;
+
 	float Min, Max;
 	GetMaxMinForQuantity(NewQuantity, Min, Max);
 	for (AObst* Obst : Obstructions)
 	{
+		Obst->SetActiveQuantity(NewQuantity);
 		Obst->UpdateColorMapScale(Min, Max);
+	}
+
+	// Inactive obstructions will rebuild their playback descriptor as soon as they get activated
+	for (AObst* Obst : ActiveObstructions)
+	{
+		Obst->BuildPlaybackDescriptor();
+		Obst->UpdateTexture(CurrentTimeSteps["Obst"] - 1);
+		Obst->UpdateTexture(CurrentTimeSteps["Obst"]);
+	}
+
+	// The timestep might have advanced while prefetching, the textures that are missing from the window now are
+	// streamed in the background, the upcoming ones are streamed by LoadUnloadTimeStep as usual
+	TArray<FSoftObjectPath> TexturePaths;
+	ForEachObstWindowTexture(NewQuantity, [this, &TexturePaths](const FSoftObjectPath& TexturePath, const AObst* Owner)
+	{
+		TexturePaths.Add(TexturePath);
+		AddResidentTexture(TexturePath, "Obst", Owner);
+	});
+	if (TexturePaths.Num() > 0) StreamableManager.RequestAsyncLoad(TexturePaths);
 
-		TArray<int> Orientations;
-		Cast<UBoundaryDataInfo>(Obst->DataAsset->DataInfo)->Dimensions.GetKeys(Orientations);
-		for (const int Orientation : Orientations)
+	GI->OnActiveAssetsChanged();
+}
+
+void ASimulation::ForEachObstWindowTexture(const FString& Quantity,
+                                           TFunctionRef<void(const FSoftObjectPath&, const AObst*)> Function) const
+{
+	if (ActiveObstructions.Num() == 0) return;
+
+	// The same window RegisterTextureLoad loads when an obstruction is activated
+	const int TimeStep = FMath::Max(0, CurrentTimeSteps["Obst"]);
+	const int NumTimeSteps = FPlaybackWindow::GetNumInitialTimeSteps(MaxTimeSteps["Obst"]);
+	const auto ForEachWindowTexture = [&](const TArray<FSoftObjectPath>& TexturePaths, const AObst* Owner)
+	{
+		for (int i = 0; i < NumTimeSteps && TexturePaths.Num() > 0; ++i)
+			Function(TexturePaths[(TimeStep + i) % TexturePaths.Num()], Owner);
+	};
+
+	// The atlas textures are shared by all obstructions
+	if (const TArray<FSoftObjectPath>* AtlasTexturePaths = GetObstAtlasTexturePaths(Quantity))
+	{
+		ForEachWindowTexture(*AtlasTexturePaths, nullptr);
+		return;
+	}
+	for (const AObst* Obst : ActiveObstructions)
+	{
+		if (const FFixedQuantityObstTextures* QuantityTextures = Cast<UObstAsset>(Obst->DataAsset)->ObstTextures.
+			Find(Quantity))
 		{
-			// Initialize resources for timestep t=-1 and t=0 (for time interpolation)
-			Obst->UpdateTexture(CurrentTimeSteps["Obst"] - 1, Orientation);
-			Obst->UpdateTexture(CurrentTimeSteps["Obst"], Orientation);
+			for (const TPair<int, FFixedFaceObstTextures>& FaceTextures : QuantityTextures->ForOrientation)
+				ForEachWindowTexture(FaceTextures.Value.Textures, Obst);
 		}
 	}
-
-	GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->OnActiveAssetsChanged();
 }
 
 void ASimulation::GetMaxMinForQuantity(const FString Quantity, float& MinOut, float& MaxOut) const
 {
-	float SMin, SMax, OMin, OMax;
-	GetSlicesMaxMinForQuantity(Quantity, SMin, SMax);
-	GetObstructionsMaxMinForQuantity(Quantity, OMin, OMax);
-	MinOut = FMath::Min(SMin, OMin);
-	MaxOut = FMath::Max(SMax, OMax);
+	const float* Min = QuantityMins.Find(Quantity);
+	MinOut = Min ? *Min : TNumericLimits<float>::Max();
+	MaxOut = Min ? QuantityMaxs[Quantity] : TNumericLimits<float>::Min();
+}
+
+void ASimulation::BuildQuantityRanges()
+{
+	QuantityMins.Reset();
+	QuantityMaxs.Reset();
+	const auto AddRange = [this](const FString& Quantity, const float Min, const float Max)
+	{
+		if (float* QuantityMin = QuantityMins.Find(Quantity))
+		{
+			*QuantityMin = FMath::Min(Min, *QuantityMin);
+			QuantityMaxs[Quantity] = FMath::Max(Max, QuantityMaxs[Quantity]);
+		}
+		else
+		{
+			QuantityMins.Add(Quantity, Min);
+			QuantityMaxs.Add(Quantity, Max);
+		}
+	};
+
+	TSet<FString> Quantities = TSet<FString>();
+	for (const ASlice* Slice : Slices)
+	{
+		const USliceDataInfo* DataInfo = Cast<USliceDataInfo>(Slice->DataAsset->DataInfo);
+		AddRange(DataInfo->Quantity, DataInfo->MinValue, DataInfo->MaxValue);
+		Quantities.Add(DataInfo->Quantity);
+	}
+	SliceQuantities = Quantities.Array();
+
+	for (const AObst* Obst : Obstructions)
+	{
+		const UBoundaryDataInfo* DataInfo = Cast<UBoundaryDataInfo>(Obst->DataAsset->DataInfo);
+		for (const TPair<FString, float>& Min : DataInfo->MinValues)
+			if (const float* Max = DataInfo->MaxValues.Find(Min.Key)) AddRange(Min.Key, Min.Value, *Max);
+	}
 }
 
 void ASimulation::GetMaxMins(UPARAM(ref) TMap<FString, float>& Mins, UPARAM(ref) TMap<FString, float>& Maxs) const
@@ -646,52 +973,28 @@ void ASimulation::GetMaxMins(UPARAM(ref) TMap<FString, float>& Mins, UPARAM(ref)
 	}
 }
 
-bool ASimulation::RegisterTextureLoad(const FString Type, const AActor* Asset, const FString& TextureDirectory,
-                                      UPARAM(ref) TArray<FAssetData>& TextureArray, const int NumTextures)
+bool ASimulation::RegisterTextureLoad(const FString Type, const AActor* Asset,
+                                      const TArray<FSoftObjectPath>& TexturePaths, const int NumTimeSteps,
+                                      const int TimeStepsPerTexture, const bool bIsAtlas)
 {
-	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(UTexture::StaticClass(), false, false);
-	ObjectLibrary->AddToRoot();
-	TextureArray.Reserve(NumTextures);
-	// Check if there are any assets in the directory
-	ObjectLibrary->LoadAssetDataFromPath(TextureDirectory);
-	ObjectLibrary->GetAssetDataList(TextureArray);
-
-	// Check if the expected amount of data (textures) could be found in the given directory
-	if (TextureArray.Num() != NumTextures)
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_RegisterTextureLoad);
+	const int NumTextures = FMath::DivideAndRoundUp(NumTimeSteps, TimeStepsPerTexture);
+	// Check if the expected amount of textures is listed in the (ordered) table written by the importer
+	if (TexturePaths.Num() != NumTextures)
 	{
-		FString OriginalDataDirectory, SimName;
-		FImportUtils::SplitPath(SimulationAsset->SimInfo->SmokeViewOriginalFilePath, OriginalDataDirectory, SimName);
-		// If not, load the data now
-		UDataInfo* DataInfo = Cast<AFdsActor>(Asset)->DataAsset->DataInfo;
-		
-		FAssetCreationUtils::LoadTextures(DataInfo, Type);
-
-		// Todo: Load the data in the background and add a loading queue in UI
-
-		TArray<FString> PathsToScan = TArray<FString>();
-		PathsToScan.Add(TextureDirectory);
-		const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
-			"AssetRegistry");
-		AssetRegistryModule.Get().ScanPathsSynchronous(PathsToScan, true);
-
-		ObjectLibrary->ClearLoaded();
-		ObjectLibrary->LoadAssetDataFromPath(TextureDirectory);
-		ObjectLibrary->GetAssetDataList(TextureArray);
+		UE_LOG(LogSimulation, Warning, TEXT("Expected %d textures for %s, but the asset lists %d"), NumTextures,
+		       *Asset->GetName(), TexturePaths.Num());
+		return false;
 	}
-
-	TextureArray.Sort([](const FAssetData& Lhs, const FAssetData& Rhs)
+	// The textures are only created when needed for the first time, which is the case if the last one is missing
+	else if (NumTextures > 0 && !FPackageName::DoesPackageExist(TexturePaths.Last().GetLongPackageName()))
 	{
-		int LeftNum, RightNum;
-		FString Left, Right;
-		Lhs.AssetName.ToString().Split(TEXT("_t"), &Left, &Right, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
-		FDefaultValueHelper::ParseInt(Right, LeftNum);
-		Rhs.AssetName.ToString().Split(TEXT("_t"), &Left, &Right, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
-		FDefaultValueHelper::ParseInt(Right, RightNum);
-		return LeftNum < RightNum;
-	});
+		// Todo: Load the data in the background and add a loading queue in UI
+		FAssetCreationUtils::LoadTextures(Cast<AFdsActor>(Asset)->DataAsset->DataInfo, Type);
+	}
 
-	// Load first n (max 10) textures synchronously so they will be available from the very beginning
-	const int TexturesToLoad = FMath::Min(TextureArray.Num(), 10);
+	// Load the textures of the first few timesteps synchronously so they will be available from the beginning
+	const int TexturesToLoad = FPlaybackWindow::GetNumInitialTimeSteps(NumTextures > 0 ? NumTimeSteps : 0);
 
 	// Make sure any Textures could be found
 	if (TexturesToLoad == 0)
@@ -704,106 +1007,169 @@ bool ASimulation::RegisterTextureLoad(const FString Type, const AActor* Asset, c
 
 	for (int i = 0; i < TexturesToLoad; ++i)
 	{
-		StreamableManager.LoadSynchronous(TextureArray[(CurrentTimeSteps[Type] + i) % MaxTimeSteps[Type]].ToSoftObjectPath());
+		const FSoftObjectPath& TexturePath = TexturePaths[FPlaybackWindow::GetTextureIndex(
+			(CurrentTimeSteps[Type] + i) % MaxTimeSteps[Type], TimeStepsPerTexture)];
+		StreamableManager.LoadSynchronous(TexturePath);
+		AddResidentTexture(TexturePath, Type, bIsAtlas ? nullptr : Asset);
+	}
+	return true;
+}
+
+bool ASimulation::RegisterTimeSeries(const AFdsActor* Actor) const
+{
+	// Time series are streamed by the actors themselves, so there is nothing to load in advance
+	if (!Actor->DataAsset->TimeSeries->HasDataFile())
+	{
+		UE_LOG(LogSimulation, Warning, TEXT("The time series file %s of %s is missing"),
+		       *Actor->DataAsset->TimeSeries->GetDataFilePath(), *Actor->GetName());
+		return false;
 	}
 	return true;
 }
 
 void ASimulation::NextTimeStep(const FString Type)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_NextTimeStep);
+	const double StartTime = FPlatformTime::Seconds();
 	const AVRSSHUD* HUD = Cast<AVRSSHUD>(UGameplayStatics::GetPlayerController(GetWorld(), 0)->GetHUD());
-	CurrentTimeSteps[Type] += 1;
-	if (CurrentTimeSteps[Type] >= MaxTimeSteps[Type])
+	// If the last time step is reached for one type, set time for ALL types back to 0. Also reset all timers to
+	// synchronize them again. This is necessary because the different types end at a different absolute time,
+	// because the output rate is fixed and might not match with the simulation time. The time remaining after the
+	// last output step will therefore vary for each type. We just end the simulation as soon as one type ends.
+	// This behavior could be changed and is simply a design decision.
+	const bool bStartedOver = FPlaybackWindow::AdvanceTimeStep(
+		Type, CurrentTimeSteps, MaxTimeSteps, [this](const FString& SkippedType, const int SkippedTimeStep)
+		{
+			LoadUnloadTimeStep(SkippedTimeStep, SkippedType);
+		});
+	if (bStartedOver)
 	{
 		HUD->UserInterfaceUserWidget->TimeUserWidget->CurrentSimTime = .0f;
-
-		// If the last time step is reached for one type, set time for ALL types back to 0. Also reset all timers to
-		// synchronize them again. This is necessary because the different types end at a different absolute time,
-		// because the output rate is fixed and might not match with the simulation time. The time remaining after the
-		// last output step will therefore vary for each type. We just end the simulation as soon as one type ends.
-		// This behavior could be changed and is simply a design decision.
-		TArray<FString> Types;
-		CurrentTimeSteps.GetKeys(Types);
-		for (FString& ItType : Types)
-		{			
+		bFinishPlaybackBenchmark = PlaybackBenchmark.IsValid();
+		for (const TPair<FString, int>& TimeStep : CurrentTimeSteps)
+		{
 			FTimerDelegate Delegate;
-			Delegate.BindUFunction(this, FName("NextTimeStep"), ItType);
-			GetWorld()->GetTimerManager().ClearTimer(UpdateTimerHandles[ItType]);
-			if (Type == ItType)
-			{
-				GetWorld()->GetTimerManager().SetTimer(UpdateTimerHandles[ItType], Delegate, UpdateRates[ItType], true, UpdateRates[ItType]);
-				
-				CurrentTimeSteps[ItType] = 0;
-			} else
-			{
-				GetWorld()->GetTimerManager().SetTimer(UpdateTimerHandles[ItType], Delegate, UpdateRates[ItType], true, 0);
-
-				// Step through all timesteps that will be skipped by setting time back to 0
-				for (int t = CurrentTimeSteps[ItType]; t < MaxTimeSteps[ItType]; ++t){
-					LoadUnloadTimeStep(t, ItType);
-				}
-				
-				CurrentTimeSteps[ItType] = -1;
-			}
+			Delegate.BindUFunction(this, FName("NextTimeStep"), TimeStep.Key);
+			GetWorld()->GetTimerManager().ClearTimer(UpdateTimerHandles[TimeStep.Key]);
+			// The other types continue with their first timestep at once
+			GetWorld()->GetTimerManager().SetTimer(UpdateTimerHandles[TimeStep.Key], Delegate,
+			                                       UpdateRates[TimeStep.Key], true,
+			                                       TimeStep.Key == Type ? UpdateRates[TimeStep.Key] : 0);
 		}
 	}
 	LoadUnloadTimeStep(CurrentTimeSteps[Type], Type);
+
+	if (PlaybackBenchmark)
+	{
+		PlaybackBenchmark->AddNextTimeStepTime(FPlatformTime::Seconds() - StartTime);
+		PlaybackBenchmark->SampleTextureMemory();
+		if (bFinishPlaybackBenchmark) FinishPlaybackBenchmark();
+	}
 }
 
 void ASimulation::LoadUnloadTimeStep(const int TimeStep, const FString& Type){
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_LoadUnloadTimeStep);
+	const double StartTime = FPlatformTime::Seconds();
 	const AVRSSHUD* HUD = Cast<AVRSSHUD>(UGameplayStatics::GetPlayerController(GetWorld(), 0)->GetHUD());
 	// Unload the VolumeTexture of the second to last time step (not the last one as it might still be referenced)
-	const int PreviousTextureIndex = (TimeStep + MaxTimeSteps[Type] - 2) % MaxTimeSteps[Type];
-	const int NextTextureIndex = (TimeStep + 9) % MaxTimeSteps[Type];
-	TArray<FSoftObjectPath> AssetsToLoad;
+	const int PreviousTextureIndex = FPlaybackWindow::GetUnloadTimeStep(TimeStep, MaxTimeSteps[Type]);
+	const int NextTextureIndex = FPlaybackWindow::GetPrefetchTimeStep(TimeStep, MaxTimeSteps[Type]);
 
-	TArray<FAssetData> CurrentTextureArray;
-	if (Type.Equals("Obst"))
-	{
-		const FString& ActiveObstQuantity = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->Config->
-															   GetActiveObstQuantity();
+	PendingTextureLoads.Reset();
+	const int32 PendingTextureLoadsCapacity = PendingTextureLoads.Max();
+	const int32 StreamingRequestsCapacity = StreamingRequests.Max();
+	const int32 FreeStreamingRequestsCapacity = FreeStreamingRequests.Max();
 
-		for (const AObst* Obst : Obstructions)
+	const auto StreamChannels = [&](const AFdsActor* Actor)
+	{
+		for (const FFdsTextureChannel& Channel : Actor->PlaybackDescriptor.Channels)
 		{
-			if (!Obst->IsHidden())
+			// Channels of an atlas don't have textures on their own and time series are streamed by the actors
+			if (Channel.TexturePaths.Num() == 0) continue;
+
+			// Texture arrays are only unloaded once their last timestep has passed and only requested once for their
+			// first timestep
+			const FSoftObjectPath* TexturePaths = Channel.TexturePaths.GetData();
+			const int TimeStepsPerTexture = Channel.TimeStepsPerTexture;
+			if (FPlaybackWindow::ShouldUnloadTexture(PreviousTextureIndex, TimeStepsPerTexture, MaxTimeSteps[Type]))
+			{
+				const FSoftObjectPath& TexturePath = TexturePaths[
+					FPlaybackWindow::GetTextureIndex(PreviousTextureIndex, TimeStepsPerTexture)];
+				StreamableManager.Unload(TexturePath);
+				RemoveResidentTexture(TexturePath);
+			}
+			if (FPlaybackWindow::ShouldRequestTexture(NextTextureIndex, TimeStepsPerTexture))
 			{
-				TArray<int> Orientations;
-				Cast<UBoundaryDataInfo>(Obst->DataAsset->DataInfo)->Dimensions.GetKeys(Orientations);
-				for (const int Orientation : Orientations)
-				{
-					CurrentTextureArray = Cast<UObstAsset>(Obst->DataAsset)->ObstTextures[ActiveObstQuantity].ForOrientation[Orientation].Textures;
-					StreamableManager.Unload(CurrentTextureArray[PreviousTextureIndex].ToSoftObjectPath());
-					AssetsToLoad.Add(CurrentTextureArray[NextTextureIndex].ToSoftObjectPath());
-				}
+				PendingTextureLoads.Add(
+					TexturePaths[FPlaybackWindow::GetTextureIndex(NextTextureIndex, TimeStepsPerTexture)]);
+				AddResidentTexture(PendingTextureLoads.Last(), Type, Actor);
 			}
 		}
-	}
-	else if (Type.Equals("Slice"))
+	};
+
+	if (Type.Equals("Obst"))
 	{
-		for (const ASlice* Slice : Slices)
+		for (const AObst* Obst : ActiveObstructions) StreamChannels(Obst);
+
+		// The atlas textures are shared by all obstructions, so they only have to be streamed once
+		const TArray<FSoftObjectPath>* AtlasTexturePaths = GetObstAtlasTexturePaths(ObstQuantity);
+		if (AtlasTexturePaths && ActiveObstructions.Num() > 0)
 		{
-			if (!Slice->IsHidden())
-			{
-				CurrentTextureArray = Cast<USliceAsset>(Slice->DataAsset)->SliceTextures;
-				StreamableManager.Unload(CurrentTextureArray[PreviousTextureIndex].ToSoftObjectPath());
-				AssetsToLoad.Add(CurrentTextureArray[NextTextureIndex].ToSoftObjectPath());
-			}
+			StreamableManager.Unload((*AtlasTexturePaths)[PreviousTextureIndex % AtlasTexturePaths->Num()]);
+			RemoveResidentTexture((*AtlasTexturePaths)[PreviousTextureIndex % AtlasTexturePaths->Num()]);
+			PendingTextureLoads.Add((*AtlasTexturePaths)[NextTextureIndex % AtlasTexturePaths->Num()]);
+			AddResidentTexture(PendingTextureLoads.Last(), Type, nullptr);
 		}
 	}
+	else if (Type.Equals("Slice"))
+	{
+		for (const ASlice* Slice : ActiveSlices) StreamChannels(Slice);
+	}
 	else if (Type.Equals("Volume"))
 	{
-		for (const ARaymarchVolume* Volume : Volumes)
+		for (const ARaymarchVolume* Volume : ActiveVolumes) StreamChannels(Volume);
+	}
+
+	++PlaybackStats.NumStreamedTimeSteps;
+	PlaybackStats.NumTextureRequests += PendingTextureLoads.Num();
+
+	if (PendingTextureLoads.Num() > 0)
+	{
+		// All textures of the window are requested, even those that are still in memory: unloaded textures stay there
+		// until they are garbage collected and only the request keeps them from being collected. The paths are collected
+		// in a request slot that is reused once its request has finished, so requests don't allocate once enough slots
+		// exist. Textures that were still resident count as hits
+		const int32 RequestIndex = FreeStreamingRequests.Num() > 0
+			                           ? FreeStreamingRequests.Pop(false)
+			                           : StreamingRequests.AddDefaulted();
+		FStreamingRequest& Request = StreamingRequests[RequestIndex];
+		const int32 StreamedTexturesCapacity = Request.StreamedTextures.Max();
+		int32 NumResidentTextures = 0;
+		for (const FSoftObjectPath& TexturePath : PendingTextureLoads)
 		{
-			if (!Volume->IsHidden())
-			{
-				CurrentTextureArray = Cast<UVolumeAsset>(Volume->DataAsset)->VolumeTextures;
-				StreamableManager.Unload(CurrentTextureArray[PreviousTextureIndex].ToSoftObjectPath());
-				AssetsToLoad.Add(CurrentTextureArray[NextTextureIndex].ToSoftObjectPath());
-			}
+			if (TexturePath.ResolveObject()) ++NumResidentTextures;
+			Request.StreamedTextures.Add(TexturePath);
 		}
+		if (Request.StreamedTextures.Max() != StreamedTexturesCapacity) ++PlaybackStats.NumStreamingAllocations;
+
+		INC_DWORD_STAT_BY(STAT_VRSS_TextureRequests, PendingTextureLoads.Num());
+		INC_DWORD_STAT_BY(STAT_VRSS_TextureMisses, PendingTextureLoads.Num() - NumResidentTextures);
+		if (PlaybackBenchmark) PlaybackBenchmark->AddTextureRequest(PendingTextureLoads.Num(), NumResidentTextures);
+
+		Request.RequestTime = FPlatformTime::Seconds();
+		// The StreamableManager keeps its own copy of the requested paths
+		++PlaybackStats.NumStreamingAllocations;
+		StreamableManager.RequestAsyncLoad(Request.StreamedTextures, FStreamableDelegate::CreateUObject(
+			                                   this, &ASimulation::OnTexturesStreamed, RequestIndex));
 	}
 
-	if (AssetsToLoad.Num() > 0) StreamableManager.RequestAsyncLoad(AssetsToLoad);
+	if (PendingTextureLoads.Max() != PendingTextureLoadsCapacity) ++PlaybackStats.NumStreamingAllocations;
+	if (StreamingRequests.Max() != StreamingRequestsCapacity) ++PlaybackStats.NumStreamingAllocations;
+	if (FreeStreamingRequests.Max() != FreeStreamingRequestsCapacity) ++PlaybackStats.NumStreamingAllocations;
+
+	// The timesteps skipped when the simulation starts over are not shown and therefore can't stall
+	if (PlaybackBenchmark && TimeStep == CurrentTimeSteps[Type])
+		PlaybackBenchmark->AddTimeStep(!IsTimeStepResident(TimeStep, Type));
 
 	UpdateDataEvents[Type].Broadcast(CurrentTimeSteps[Type]);
 
@@ -811,4 +1177,230 @@ void ASimulation::LoadUnloadTimeStep(const int TimeStep, const FString& Type){
 	HUD->UserInterfaceUserWidget->TimeUserWidget->GetTextBlockValueTimesteps(Type)->SetText(
 		FText::AsNumber(CurrentTimeSteps[Type]));
 	HUD->UserInterfaceUserWidget->TimeUserWidget->CurrentSimTime = CurrentTimeSteps[Type] * UpdateRates[Type];
+	if (PlaybackBenchmark) PlaybackBenchmark->AddLoadUnloadTimeStepTime(FPlatformTime::Seconds() - StartTime);
+}
+
+bool ASimulation::IsTimeStepResident(const int TimeStep, const FString& Type) const
+{
+	const auto IsActorResident = [TimeStep](const AFdsActor* Actor)
+	{
+		for (const FFdsTextureChannel& Channel : Actor->PlaybackDescriptor.Channels)
+		{
+			const int TextureIndex = FPlaybackWindow::GetTextureIndex(TimeStep, Channel.TimeStepsPerTexture);
+			if (Channel.TexturePaths.IsValidIndex(TextureIndex) && !Channel.TexturePaths[TextureIndex].ResolveObject())
+				return false;
+		}
+		return true;
+	};
+
+	if (Type.Equals("Obst"))
+	{
+		for (const AObst* Obst : ActiveObstructions)
+			if (!IsActorResident(Obst)) return false;
+
+		const TArray<FSoftObjectPath>* AtlasTexturePaths = GetObstAtlasTexturePaths(ObstQuantity);
+		if (AtlasTexturePaths && ActiveObstructions.Num() > 0)
+			return (*AtlasTexturePaths)[TimeStep % AtlasTexturePaths->Num()].ResolveObject() != nullptr;
+	}
+	else if (Type.Equals("Slice"))
+	{
+		for (const ASlice* Slice : ActiveSlices)
+			if (!IsActorResident(Slice)) return false;
+	}
+	else if (Type.Equals("Volume"))
+	{
+		for (const ARaymarchVolume* Volume : ActiveVolumes)
+			if (!IsActorResident(Volume)) return false;
+	}
+	return true;
+}
+
+void ASimulation::StartPlaybackBenchmark(const FPlaybackBenchmarkSettings& Settings)
+{
+	if (!bIsInitialized || CurrentTimeSteps.Num() == 0)
+	{
+		UE_LOG(LogSimulation, Warning, TEXT("The playback of %s can only be benchmarked once it has been initialized"),
+		       *GetName());
+		return;
+	}
+
+	const auto IsChosen = [&Settings](const AFdsActor* Actor)
+	{
+		if (Settings.ActorNames.Num() == 0) return true;
+		for (const FString& ActorName : Settings.ActorNames)
+			if (Actor->DataAsset->DataInfo->ImportName.Contains(ActorName)) return true;
+		return false;
+	};
+	for (AObst* Obst : Obstructions)
+	{
+		if (Settings.bObstructions && IsChosen(Obst))
+		{
+			if (Obst->IsHidden()) ActivateObst(Obst);
+		}
+		else if (!Obst->IsHidden()) DeactivateObst(Obst);
+	}
+	for (ASlice* Slice : Slices)
+	{
+		if (Settings.bSlices && IsChosen(Slice))
+		{
+			if (Slice->IsHidden()) ActivateSlice(Slice);
+		}
+		else if (!Slice->IsHidden()) DeactivateSlice(Slice);
+	}
+	for (ARaymarchVolume* Volume : Volumes)
+	{
+		if (Settings.bVolumes && IsChosen(Volume))
+		{
+			if (Volume->IsHidden()) ActivateVolume(Volume);
+		}
+		else if (!Volume->IsHidden()) DeactivateVolume(Volume);
+	}
+	GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>()->OnActiveAssetsChanged();
+
+	if (Settings.UpdateRate > 0)
+	{
+		TArray<FString> Types;
+		UpdateRates.GetKeys(Types);
+		for (const FString& Type : Types) SetUpdateRate(Type, Settings.UpdateRate);
+	}
+	if (bIsPaused) TogglePauseSimulation();
+	// Start from the first timestep of all types
+	RewindSimulation(TNumericLimits<float>::Max());
+
+	PlaybackBenchmark = MakeUnique<FPlaybackBenchmark>(Settings);
+	bFinishPlaybackBenchmark = false;
+
+	// The jumps are distributed evenly over the time it takes until the simulation starts over
+	float Duration = TNumericLimits<float>::Max();
+	for (const TPair<FString, int>& MaxTimeStep : MaxTimeSteps)
+		Duration = FMath::Min(Duration, MaxTimeStep.Value * UpdateRates[MaxTimeStep.Key]);
+	for (int i = 0; i < Settings.NumSeekBursts; ++i)
+	{
+		const bool bForward = i % 2 == 0;
+		const FTimerDelegate SeekBurst = FTimerDelegate::CreateWeakLambda(
+			this, [this, bForward, Steps = Settings.SeekBurstSteps]
+			{
+				if (bForward) FastForwardSimulation(Steps);
+				else RewindSimulation(Steps);
+			});
+		GetWorldTimerManager().SetTimer(SeekBurstTimerHandles.AddDefaulted_GetRef(), SeekBurst,
+		                                Duration * (i + 1) / (Settings.NumSeekBursts + 1), false);
+	}
+
+	UE_LOG(LogSimulation, Log, TEXT("Started playback benchmark of %s with %d obstructions, %d slices and %d volumes"),
+	       *GetName(), ActiveObstructions.Num(), ActiveSlices.Num(), ActiveVolumes.Num());
+}
+
+bool ASimulation::IsPlaybackBenchmarkRunning() const
+{
+	return PlaybackBenchmark.IsValid();
+}
+
+void ASimulation::FinishPlaybackBenchmark()
+{
+	bFinishPlaybackBenchmark = false;
+	for (FTimerHandle& SeekBurstTimerHandle : SeekBurstTimerHandles)
+		GetWorldTimerManager().ClearTimer(SeekBurstTimerHandle);
+	SeekBurstTimerHandles.Reset();
+
+	const FPlaybackBenchmarkResults Results = PlaybackBenchmark->GetResults();
+	UE_LOG(LogSimulation, Log,
+	       TEXT("Playback benchmark of %s: %d timesteps, %d stalled, cache hit rate %.2f, stream latency %.2fms "
+		       "(p95 %.2fms, max %.2fms), NextTimeStep %.3fms (max %.3fms), peak texture memory %lld bytes"),
+	       *GetName(), Results.NumTimeSteps, Results.NumStalledTimeSteps, Results.CacheHitRate,
+	       Results.MeanStreamLatency, Results.P95StreamLatency, Results.MaxStreamLatency, Results.MeanNextTimeStepTime,
+	       Results.MaxNextTimeStepTime, Results.PeakTextureMemory);
+	if (!PlaybackBenchmark->WriteReport(Results))
+		UE_LOG(LogSimulation, Warning, TEXT("Could not write the report of the playback benchmark of %s"), *GetName());
+
+	const bool bQuit = PlaybackBenchmark->Settings.bQuitWhenFinished;
+	PlaybackBenchmark.Reset();
+	PlaybackBenchmarkFinishedEvent.Broadcast(Results);
+	if (bQuit) UKismetSystemLibrary::QuitGame(this, nullptr, EQuitPreference::Quit, false);
+}
+
+void ASimulation::OnTexturesStreamed(const int32 RequestIndex)
+{
+	FStreamingRequest& Request = StreamingRequests[RequestIndex];
+	if (PlaybackBenchmark) PlaybackBenchmark->AddStreamLatency(FPlatformTime::Seconds() - Request.RequestTime);
+
+#if STATS
+	int64 StreamedBytes = 0;
+	for (const FSoftObjectPath& TexturePath : Request.StreamedTextures)
+		if (const UTexture* Texture = Cast<UTexture>(TexturePath.ResolveObject()))
+			StreamedBytes += Texture->CalcTextureMemorySizeEnum(TMC_ResidentMips);
+	FVRSSStats::AddStreamedBytes(StreamedBytes);
+#endif
+
+	// Keeps the memory of the slot for the next request
+	Request.StreamedTextures.Reset();
+	FreeStreamingRequests.Push(RequestIndex);
+}
+
+void ASimulation::AddResidentTexture(const FSoftObjectPath& TexturePath, const FString& Type, const AActor* Owner)
+{
+	ResidentTextures.Add(TexturePath, {FName(Type), Owner ? Owner->GetFName() : ObstAtlasOwnerName});
+	SET_DWORD_STAT(STAT_VRSS_TexturesResident, ResidentTextures.Num());
+}
+
+void ASimulation::RemoveResidentTexture(const FSoftObjectPath& TexturePath)
+{
+	ResidentTextures.Remove(TexturePath);
+	SET_DWORD_STAT(STAT_VRSS_TexturesResident, ResidentTextures.Num());
+}
+
+void ASimulation::ReleaseResidentTextures(const FName Type, const FName ActorName)
+{
+	TArray<FSoftObjectPath> TexturePaths;
+	for (const TPair<FSoftObjectPath, FResidentTexture>& ResidentTexture : ResidentTextures)
+	{
+		if (ResidentTexture.Value.Type == Type && (ActorName.IsNone() || ResidentTexture.Value.ActorName == ActorName))
+			TexturePaths.Add(ResidentTexture.Key);
+	}
+	for (const FSoftObjectPath& TexturePath : TexturePaths)
+	{
+		StreamableManager.Unload(TexturePath);
+		RemoveResidentTexture(TexturePath);
+	}
+}
+
+FSimulationMemoryUsage ASimulation::GetMemoryUsage() const
+{
+	FSimulationMemoryUsage Usage;
+	Usage.SimulationName = GetName();
+
+	const auto AddUsage = [&Usage](const FString& Type, const FString& ActorName, const FVRSSMemoryUsage& TextureUsage)
+	{
+		Usage.Total += TextureUsage;
+		Usage.PerType.FindOrAdd(Type) += TextureUsage;
+		Usage.PerActor.FindOrAdd(ActorName) += TextureUsage;
+	};
+
+	// Textures may already have been requested, but not finished loading yet
+	for (const TPair<FSoftObjectPath, FResidentTexture>& ResidentTexture : ResidentTextures)
+		if (UTexture* Texture = Cast<UTexture>(ResidentTexture.Key.ResolveObject()))
+			AddUsage(ResidentTexture.Value.Type.ToString(), ResidentTexture.Value.ActorName.ToString(),
+			         GetTextureMemoryUsage(Texture));
+
+	// Time series are streamed by the actors themselves into their own textures
+	const auto AddTimeSeriesUsage = [&AddUsage](const FString& Type, const AFdsActor* Actor)
+	{
+		for (UTexture* Texture : Actor->GetTimeSeriesTextures())
+			if (Texture) AddUsage(Type, Actor->GetName(), GetTextureMemoryUsage(Texture));
+	};
+	for (const ASlice* Slice : Slices) AddTimeSeriesUsage("Slice", Slice);
+	for (const ARaymarchVolume* Volume : Volumes) AddTimeSeriesUsage("Volume", Volume);
+
+	return Usage;
+}
+
+FVRSSMemoryUsage ASimulation::GetTextureMemoryUsage(UTexture* Texture)
+{
+	FResourceSizeEx ResourceSize(EResourceSizeMode::Exclusive);
+	Texture->GetResourceSizeEx(ResourceSize);
+
+	FVRSSMemoryUsage Usage;
+	Usage.CpuBytes = ResourceSize.GetDedicatedSystemMemoryBytes() + ResourceSize.GetUnknownMemoryBytes();
+	Usage.GpuBytes = ResourceSize.GetDedicatedVideoMemoryBytes();
+	return Usage;
 }
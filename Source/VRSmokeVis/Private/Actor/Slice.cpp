@@ -1,12 +1,16 @@
 #include "Actor/Slice.h"
 
 #include "VRSSConfig.h"
+#include "VRSSStats.h"
 #include "VRSSGameInstanceSubsystem.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/Texture2DArray.h"
 #include "Util/TextureUtilities.h"
 #include "Assets/SliceAsset.h"
 #include "Actor/Simulation.h"
 #include "Assets/SliceDataInfo.h"
+#include "Assets/FdsTimeSeriesAsset.h"
+#include "Util/PlaybackWindow.h"
 
 DEFINE_LOG_CATEGORY(LogSlice)
 
@@ -71,9 +75,27 @@ void ASlice::BeginPlay()
 
 void ASlice::UpdateTexture(const int CurrentTimeStep)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_UpdateSlice);
 	// Load the texture for the next time step to interpolate between the next and current one
-	UTexture2D* NextTexture = Cast<UTexture2D>(
-		Cast<USliceAsset>(DataAsset)->SliceTextures[(CurrentTimeStep + 1) % Cast<USliceAsset>(DataAsset)->SliceTextures.Num()].GetAsset());
+	const FFdsTextureChannel& Channel = PlaybackDescriptor.Channels[0];
+	const int NextTimeStep = (CurrentTimeStep + 1) % static_cast<int>(Channel.Dimensions.W);
+	if (DataAsset->TimeSeries)
+	{
+		StreamTimeSeries(NextTimeStep);
+
+		TimePassedPercentage = 0;
+		SliceMaterial->SetTextureParameterValue("TextureT0", GetTimeSeriesTextureT0());
+		SliceMaterial->SetTextureParameterValue("TextureT1", GetTimeSeriesTextureT1());
+		SliceMaterial->SetScalarParameterValue("TimePassedPercentage", TimePassedPercentage);
+		return;
+	}
+	if (Channel.TimeStepsPerTexture > 1)
+	{
+		UpdateTextureArrayLayer(NextTimeStep);
+		return;
+	}
+
+	UTexture2D* NextTexture = Cast<UTexture2D>(Channel.TexturePaths[NextTimeStep].TryLoad());
 
 	if (!NextTexture)
 	{
@@ -103,6 +125,41 @@ void ASlice::UpdateTexture(const int CurrentTimeStep)
 	SliceMaterial->SetScalarParameterValue("TimePassedPercentage", TimePassedPercentage);
 }
 
+void ASlice::UpdateTextureArrayLayer(const int NextTimeStep)
+{
+	const FFdsTextureChannel& Channel = PlaybackDescriptor.Channels[0];
+	UTexture2DArray* NextTextureArray = Cast<UTexture2DArray>(
+		Channel.TexturePaths[FPlaybackWindow::GetTextureIndex(NextTimeStep, Channel.TimeStepsPerTexture)].TryLoad());
+
+	if (!NextTextureArray)
+	{
+		UE_LOG(LogSlice, Error, TEXT("Tried to initialize Slice resources with no data texture arrays!"));
+		return;
+	}
+
+	TimePassedPercentage = 0;
+	DataTextureArrayT0 = DataTextureArrayT1;
+	DataLayerT0 = DataLayerT1;
+	DataTextureArrayT1 = NextTextureArray;
+	DataLayerT1 = NextTimeStep % Channel.TimeStepsPerTexture;
+
+	// Update dynamic material instance, the material samples the given layer of each texture array
+	SliceMaterial->SetTextureParameterValue("TextureArrayT0", DataTextureArrayT0);
+	SliceMaterial->SetTextureParameterValue("TextureArrayT1", DataTextureArrayT1);
+	SliceMaterial->SetScalarParameterValue("LayerT0", DataLayerT0);
+	SliceMaterial->SetScalarParameterValue("LayerT1", DataLayerT1);
+	SliceMaterial->SetScalarParameterValue("TimePassedPercentage", TimePassedPercentage);
+}
+
+void ASlice::BuildPlaybackDescriptor()
+{
+	PlaybackDescriptor.Channels.Reset();
+	FFdsTextureChannel& Channel = PlaybackDescriptor.Channels.AddDefaulted_GetRef();
+	Channel.Dimensions = Cast<USliceDataInfo>(DataAsset->DataInfo)->Dimensions;
+	Channel.TexturePaths = Cast<USliceAsset>(DataAsset)->SliceTextures;
+	Channel.TimeStepsPerTexture = FMath::Max(1, Cast<USliceDataInfo>(DataAsset->DataInfo)->TimeStepsPerTexture);
+}
+
 void ASlice::UpdateColorMapScale(const float NewMin, const float NewMax) const
 {
 	const USliceDataInfo* SliceDataInfo = Cast<USliceDataInfo>(DataAsset->DataInfo);
@@ -2,7 +2,12 @@
 
 int64 UBoundaryDataInfo::GetByteSize(const int Face) const
 {
-	return Dimensions[Face].X * Dimensions[Face].Y * Dimensions[Face].W;
+	return GetTimeStepByteSize(Face) * FMath::RoundToInt(Dimensions[Face].W);
+}
+
+int64 UBoundaryDataInfo::GetTimeStepByteSize(const int Face) const
+{
+	return static_cast<int64>(FMath::RoundToInt(Dimensions[Face].X)) * FMath::RoundToInt(Dimensions[Face].Y);
 }
 
 int64 UBoundaryDataInfo::GetByteSize() const
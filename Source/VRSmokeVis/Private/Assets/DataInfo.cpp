@@ -1,2 +1,98 @@
 #include "Assets/DataInfo.h"
 
+
+bool FDataStatistics::IsValid() const
+{
+	return TimeStepMaxs.Num() > 0;
+}
+
+int FDataStatistics::GetNumTimeSteps() const
+{
+	return TimeStepMaxs.Num();
+}
+
+bool FDataStatistics::IsTimeStepEmpty(const int TimeStep, const uint8 EmptyValue) const
+{
+	return TimeStepMins[TimeStep] == EmptyValue && TimeStepMaxs[TimeStep] == EmptyValue;
+}
+
+bool FDataStatistics::IsBrickEmpty(const int TimeStep, const int Brick, const uint8 EmptyValue) const
+{
+	const int Index = TimeStep * NumBricks.X * NumBricks.Y * NumBricks.Z + Brick;
+	return BrickMins[Index] == EmptyValue && BrickMaxs[Index] == EmptyValue;
+}
+
+void FDataStatistics::GetValueRange(uint8& OutMin, uint8& OutMax) const
+{
+	OutMin = 255;
+	OutMax = 0;
+	for (int t = 0; t < GetNumTimeSteps(); ++t)
+	{
+		OutMin = FMath::Min(OutMin, TimeStepMins[t]);
+		OutMax = FMath::Max(OutMax, TimeStepMaxs[t]);
+	}
+}
+
+uint8 FDataStatistics::GetPercentile(const float Percentile) const
+{
+	int64 NumValues = 0;
+	for (const int64 Count : Histogram) NumValues += Count;
+
+	const int64 Threshold = FMath::CeilToDouble(NumValues * static_cast<double>(FMath::Clamp(Percentile, 0.f, 1.f)));
+	int64 Sum = 0;
+	for (int Value = 0; Value < Histogram.Num(); ++Value)
+	{
+		Sum += Histogram[Value];
+		if (Sum > 0 && Sum >= Threshold) return Value;
+	}
+	return 255;
+}
+
+void FDataStatistics::Merge(const FDataStatistics& Other)
+{
+	if (!IsValid())
+	{
+		TimeStepMins = Other.TimeStepMins;
+		TimeStepMaxs = Other.TimeStepMaxs;
+		Histogram = Other.Histogram;
+	}
+	else
+	{
+		const int NumTimeSteps = FMath::Min(GetNumTimeSteps(), Other.GetNumTimeSteps());
+		TimeStepMins.SetNum(NumTimeSteps);
+		TimeStepMaxs.SetNum(NumTimeSteps);
+		for (int t = 0; t < NumTimeSteps; ++t)
+		{
+			TimeStepMins[t] = FMath::Min(TimeStepMins[t], Other.TimeStepMins[t]);
+			TimeStepMaxs[t] = FMath::Max(TimeStepMaxs[t], Other.TimeStepMaxs[t]);
+		}
+		for (int Value = 0; Value < FMath::Min(Histogram.Num(), Other.Histogram.Num()); ++Value)
+			Histogram[Value] += Other.Histogram[Value];
+	}
+
+	BrickSize = NumBricks = FIntVector::ZeroValue;
+	BrickMins.Empty();
+	BrickMaxs.Empty();
+}
+
+void FDataStatistics::Append(const FDataStatistics& Other)
+{
+	if (!IsValid())
+	{
+		*this = Other;
+		return;
+	}
+	check(BrickSize == Other.BrickSize && NumBricks == Other.NumBricks)
+
+	TimeStepMins.Append(Other.TimeStepMins);
+	TimeStepMaxs.Append(Other.TimeStepMaxs);
+	BrickMins.Append(Other.BrickMins);
+	BrickMaxs.Append(Other.BrickMaxs);
+	for (int Value = 0; Value < FMath::Min(Histogram.Num(), Other.Histogram.Num()); ++Value)
+		Histogram[Value] += Other.Histogram[Value];
+}
+
+float FDataStatistics::ToValue(const uint8 StoredValue, const float MinValue, const float MaxValue)
+{
+	return MinValue + StoredValue / 255.f * (MaxValue - MinValue);
+}
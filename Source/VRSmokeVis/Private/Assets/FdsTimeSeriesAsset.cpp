@@ -0,0 +1,55 @@
+#include "Assets/FdsTimeSeriesAsset.h"
+
+#include "Async/Async.h"
+#include "HAL/PlatformFileManager.h"
+#include "Util/StagingBufferPool.h"
+#include "VRSSStats.h"
+
+DEFINE_LOG_CATEGORY(LogFdsTimeSeries)
+
+const TCHAR* UFdsTimeSeriesAsset::DataDirectory = TEXT("TimeSeries");
+
+FString UFdsTimeSeriesAsset::GetDataFilePath() const
+{
+	// The content directory is relative to the executable in packaged builds, which is where the staged files are
+	return FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectContentDir(), DataFileName));
+}
+
+bool UFdsTimeSeriesAsset::HasDataFile() const
+{
+	return FPaths::FileExists(GetDataFilePath());
+}
+
+int UFdsTimeSeriesAsset::GetNumTimeSteps() const
+{
+	return FMath::Max(0, TimeStepOffsets.Num() - 1);
+}
+
+void UFdsTimeSeriesAsset::ReadTimeStepAsync(const int TimeStep, TFunction<void(FStagingBuffer&&)>&& OnRead) const
+{
+	if (TimeStep < 0 || TimeStep >= GetNumTimeSteps()) return;
+
+	// Only copy what is needed to read the data, so the asset may be garbage collected while the read is in flight
+	const FString FilePath = GetDataFilePath();
+	const int64 Offset = TimeStepOffsets[TimeStep];
+	const int64 Size = TimeStepOffsets[TimeStep + 1] - Offset;
+	Async(EAsyncExecution::ThreadPool, [FilePath, Offset, Size, OnRead = MoveTemp(OnRead)]() mutable
+	{
+		VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_ReadTimeSeries);
+		const TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		FStagingBuffer Data(Size);
+		if (!FileHandle || !FileHandle->Seek(Offset) || !FileHandle->Read(Data.GetData(), Size))
+		{
+			UE_LOG(LogFdsTimeSeries, Error, TEXT("Could not read %lld bytes at offset %lld from %s"), Size, Offset,
+			       *FilePath);
+			return;
+		}
+
+		// Textures may only be updated from the game thread
+		AsyncTask(ENamedThreads::GameThread, [Data = MoveTemp(Data), OnRead = MoveTemp(OnRead)]() mutable
+		{
+			FVRSSStats::AddStreamedBytes(Data.Num());
+			OnRead(MoveTemp(Data));
+		});
+	});
+}
@@ -2,12 +2,24 @@
 
 int64 USliceDataInfo::GetByteSize() const
 {
-	return Dimensions.X * Dimensions.Y * Dimensions.Z * Dimensions.W;
+	return GetTotalCells() * GetNumTimeSteps();
 }
 
 int64 USliceDataInfo::GetTotalCells() const
 {
-	return Dimensions.X * Dimensions.Y * Dimensions.Z;
+	const FIntVector CellDimensions = GetCellDimensions();
+	return static_cast<int64>(CellDimensions.X) * CellDimensions.Y * CellDimensions.Z;
+}
+
+FIntVector USliceDataInfo::GetCellDimensions() const
+{
+	return FIntVector(FMath::RoundToInt(Dimensions.X), FMath::RoundToInt(Dimensions.Y),
+	                  FMath::RoundToInt(Dimensions.Z));
+}
+
+int USliceDataInfo::GetNumTimeSteps() const
+{
+	return FMath::RoundToInt(Dimensions.W);
 }
 
 FString USliceDataInfo::ToString() const
@@ -2,12 +2,45 @@
 
 int64 UVolumeDataInfo::GetByteSize() const
 {
-	return Dimensions.X * Dimensions.Y * Dimensions.Z * Dimensions.W;
+	return GetTotalVoxels() * GetNumTimeSteps();
 }
 
 int64 UVolumeDataInfo::GetTotalVoxels() const
 {
-	return Dimensions.X * Dimensions.Y * Dimensions.Z;
+	const FIntVector VoxelDimensions = GetVoxelDimensions();
+	return static_cast<int64>(VoxelDimensions.X) * VoxelDimensions.Y * VoxelDimensions.Z;
+}
+
+FIntVector UVolumeDataInfo::GetVoxelDimensions() const
+{
+	return FIntVector(FMath::RoundToInt(Dimensions.X), FMath::RoundToInt(Dimensions.Y),
+	                  FMath::RoundToInt(Dimensions.Z));
+}
+
+int UVolumeDataInfo::GetNumTimeSteps() const
+{
+	return FMath::RoundToInt(Dimensions.W);
+}
+
+int UVolumeDataInfo::GetTimeStepsPerTexture() const
+{
+	return FMath::Max(1, TimeStepsPerTexture);
+}
+
+int UVolumeDataInfo::GetNumTextures() const
+{
+	return FMath::DivideAndRoundUp(GetNumTimeSteps(), GetTimeStepsPerTexture());
+}
+
+int UVolumeDataInfo::GetNumStackedTimeSteps(const int TextureIndex) const
+{
+	const int TimeStepsPerTexture = GetTimeStepsPerTexture();
+	return FMath::Clamp(GetNumTimeSteps() - TextureIndex * TimeStepsPerTexture, 0, TimeStepsPerTexture);
+}
+
+int64 UVolumeDataInfo::GetTextureByteSize(const int TextureIndex) const
+{
+	return GetTotalVoxels() * GetNumStackedTimeSteps(TextureIndex);
 }
 
 FString UVolumeDataInfo::ToString() const
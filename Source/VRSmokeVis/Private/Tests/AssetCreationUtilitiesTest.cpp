@@ -0,0 +1,63 @@
+// Automation tests of the texture path tables of the data assets
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Assets/SliceAsset.h"
+#include "Assets/VolumeAsset.h"
+#include "Util/AssetCreationUtilities.h"
+
+
+/** Checks that the path table contains NumTextures textures with the given prefix, the n-th one being texture n */
+static void TestTexturePaths(FAutomationTestBase& Test, const TArray<FSoftObjectPath>& TexturePaths,
+                             const FString& TextureDir, const FString& TexturePrefix, const int NumTextures)
+{
+	if (!Test.TestEqual(*("Number of textures " + TexturePrefix), TexturePaths.Num(), NumTextures)) return;
+	for (int i = 0; i < NumTextures; ++i)
+	{
+		const FString TextureName = FAssetCreationUtils::GetTextureName(TexturePrefix, i);
+		Test.TestEqual(*FString::Printf(TEXT("Path of texture %d"), i), TexturePaths[i].ToString(),
+		               TextureDir + "/" + TextureName + "." + TextureName);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTexturePathTablesTest, "VRSmokeVis.AssetCreationUtils.TexturePathTables",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTexturePathTablesTest::RunTest(const FString& Parameters)
+{
+	// More than ten timesteps, so the tables can't accidentally be sorted by name (t1, t10, t11, t2, ...)
+	TestEqual(TEXT("Texture name"), FAssetCreationUtils::GetTextureName(TEXT("VT_smoke"), 12),
+	          FString(TEXT("VT_smoke_Data_t12")));
+
+	USliceAsset* SliceAsset = NewObject<USliceAsset>();
+	USliceDataInfo* SliceInfo = NewObject<USliceDataInfo>(SliceAsset);
+	SliceInfo->ImportName = TEXT("slice");
+	SliceInfo->TextureDir = TEXT("/Game/Sim/slice_1");
+	SliceInfo->Dimensions = FVector4(64, 48, 1, 23);
+	SliceAsset->DataInfo = SliceInfo;
+	FAssetCreationUtils::CreateTexturePathTables(SliceAsset, TEXT("Slice"));
+	TestTexturePaths(*this, SliceAsset->SliceTextures, SliceInfo->TextureDir, TEXT("ST_slice"), 23);
+
+	// Texture arrays are numbered by their index, not by their first timestep
+	SliceInfo->TimeStepsPerTexture = 8;
+	FAssetCreationUtils::CreateTexturePathTables(SliceAsset, TEXT("Slice"));
+	TestTexturePaths(*this, SliceAsset->SliceTextures, SliceInfo->TextureDir, TEXT("STA_slice"), 3);
+
+	UVolumeAsset* VolumeAsset = NewObject<UVolumeAsset>();
+	UVolumeDataInfo* VolumeInfo = NewObject<UVolumeDataInfo>(VolumeAsset);
+	VolumeInfo->ImportName = TEXT("smoke");
+	VolumeInfo->TextureDir = TEXT("/Game/Sim/1");
+	VolumeInfo->Dimensions = FVector4(64, 48, 32, 23);
+	VolumeAsset->DataInfo = VolumeInfo;
+	FAssetCreationUtils::CreateTexturePathTables(VolumeAsset, TEXT("Volume"));
+	TestTexturePaths(*this, VolumeAsset->VolumeTextures, VolumeInfo->TextureDir, TEXT("VT_smoke"), 23);
+
+	VolumeInfo->TimeStepsPerTexture = 2;
+	FAssetCreationUtils::CreateTexturePathTables(VolumeAsset, TEXT("Volume"));
+	TestTexturePaths(*this, VolumeAsset->VolumeTextures, VolumeInfo->TextureDir, TEXT("VTC_smoke"), 12);
+	return true;
+}
+
+#endif
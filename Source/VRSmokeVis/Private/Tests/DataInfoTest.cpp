@@ -0,0 +1,57 @@
+// Automation tests of the sizes computed by the data infos
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Assets/BoundaryDataInfo.h"
+#include "Assets/SliceDataInfo.h"
+#include "Assets/VolumeDataInfo.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDataInfoLargeSizesTest, "VRSmokeVis.DataInfo.LargeSizes",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDataInfoLargeSizesTest::RunTest(const FString& Parameters)
+{
+	// The number of voxels of a single timestep already exceeds 2^32, only the sizes are computed, nothing is allocated
+	UVolumeDataInfo* VolumeInfo = NewObject<UVolumeDataInfo>();
+	VolumeInfo->Dimensions = FVector4(2048, 2048, 1025, 5);
+	VolumeInfo->TimeStepsPerTexture = 2;
+	constexpr int64 Voxels = 2048ll * 2048 * 1025;
+	TestTrue(TEXT("Voxels exceed 2^32"), Voxels > MAX_uint32);
+	TestEqual(TEXT("Volume voxels"), VolumeInfo->GetTotalVoxels(), Voxels);
+	TestEqual(TEXT("Volume byte size"), VolumeInfo->GetByteSize(), Voxels * 5);
+
+	// Five timesteps are stacked into two full textures and a last one containing a single timestep
+	TestEqual(TEXT("Number of volume textures"), VolumeInfo->GetNumTextures(), 3);
+	TestEqual(TEXT("Timesteps of the first texture"), VolumeInfo->GetNumStackedTimeSteps(0), 2);
+	TestEqual(TEXT("Timesteps of the last texture"), VolumeInfo->GetNumStackedTimeSteps(2), 1);
+	TestEqual(TEXT("Byte size of the first texture"), VolumeInfo->GetTextureByteSize(0), Voxels * 2);
+	TestEqual(TEXT("Byte size of the last texture"), VolumeInfo->GetTextureByteSize(2), Voxels);
+	int64 TextureBytes = 0;
+	for (int i = 0; i < VolumeInfo->GetNumTextures(); ++i) TextureBytes += VolumeInfo->GetTextureByteSize(i);
+	TestEqual(TEXT("Textures contain all bytes"), TextureBytes, VolumeInfo->GetByteSize());
+
+	// Volumes imported before timesteps could be stacked store one timestep per texture
+	VolumeInfo->TimeStepsPerTexture = 0;
+	TestEqual(TEXT("Number of unstacked volume textures"), VolumeInfo->GetNumTextures(), 5);
+	TestEqual(TEXT("Byte size of an unstacked texture"), VolumeInfo->GetTextureByteSize(4), Voxels);
+
+	USliceDataInfo* SliceInfo = NewObject<USliceDataInfo>();
+	SliceInfo->Dimensions = FVector4(70000, 70000, 1, 3);
+	constexpr int64 Cells = 70000ll * 70000;
+	TestTrue(TEXT("Cells exceed 2^32"), Cells > MAX_uint32);
+	TestEqual(TEXT("Slice cells"), SliceInfo->GetTotalCells(), Cells);
+	TestEqual(TEXT("Slice byte size"), SliceInfo->GetByteSize(), Cells * 3);
+
+	UBoundaryDataInfo* BoundaryInfo = NewObject<UBoundaryDataInfo>();
+	BoundaryInfo->Dimensions.Add(1, FVector4(70000, 70000, 0, 3));
+	BoundaryInfo->Dimensions.Add(-3, FVector4(10, 20, 0, 3));
+	TestEqual(TEXT("Boundary timestep byte size"), BoundaryInfo->GetTimeStepByteSize(1), Cells);
+	TestEqual(TEXT("Boundary face byte size"), BoundaryInfo->GetByteSize(1), Cells * 3);
+	TestEqual(TEXT("Boundary byte size"), BoundaryInfo->GetByteSize(), Cells * 3 + 10 * 20 * 3);
+	return true;
+}
+
+#endif
@@ -0,0 +1,372 @@
+// Automation tests of parsing .yaml headers, reading .dat files and converting their data, run headless with
+// UnrealEditor-Cmd <Project> -ExecCmds="Automation RunTests VRSmokeVis;Quit" -nullrhi -unattended
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Assets/BoundaryDataInfo.h"
+#include "Assets/SimulationInfo.h"
+#include "Assets/SliceDataInfo.h"
+#include "Assets/VolumeDataInfo.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeExit.h"
+#include "Util/ImportUtilities.h"
+#include "Util/SyntheticDataGenerator.h"
+
+
+/** Directory the files of a test are written to, each test deletes its directory again */
+static FString GetTestDir(const TCHAR* TestName)
+{
+	return FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("VRSmokeVis"), TestName);
+}
+
+/** Reads the given range of a file directly, without going through FImportUtils */
+static TArray<uint8> ReadFileRange(const FString& FileName, const int64 Offset, const int64 Num)
+{
+	TArray<uint8> Data;
+	Data.SetNumUninitialized(Num);
+	const TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FileName));
+	if (!FileHandle || !FileHandle->Seek(Offset) || !FileHandle->Read(Data.GetData(), Num)) Data.Empty();
+	return Data;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoadDatFileTest, "VRSmokeVis.ImportUtils.LoadDatFile",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLoadDatFileTest::RunTest(const FString& Parameters)
+{
+	const FString Dir = GetTestDir(TEXT("LoadDatFile"));
+	ON_SCOPE_EXIT { IFileManager::Get().DeleteDirectory(*Dir, false, true); };
+
+	TArray<uint8> Data;
+	for (int i = 0; i < 1000; ++i) Data.Add(i * 7 % 256);
+	const FString FileName = FPaths::Combine(Dir, TEXT("Data.dat"));
+	if (!TestTrue(TEXT("Data file written"), FFileHelper::SaveArrayToFile(Data, *FileName))) return false;
+
+	// Only the requested bytes are loaded, the file may contain more
+	const FStagingBuffer Loaded = FImportUtils::LoadDatFileIntoArray(FileName, 600);
+	if (!TestTrue(TEXT("Buffer is valid"), Loaded.IsValid())) return false;
+	TestEqual(TEXT("Number of loaded bytes"), Loaded.Num(), 600ll);
+	TestEqual(TEXT("Loaded bytes equal the file"), FMemory::Memcmp(Loaded.GetData(), Data.GetData(), 600), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoadDatFileErrorsTest, "VRSmokeVis.ImportUtils.LoadDatFileErrors",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLoadDatFileErrorsTest::RunTest(const FString& Parameters)
+{
+	const FString Dir = GetTestDir(TEXT("LoadDatFileErrors"));
+	ON_SCOPE_EXIT { IFileManager::Get().DeleteDirectory(*Dir, false, true); };
+
+	AddExpectedError(TEXT("could not be opened"), EAutomationExpectedErrorFlags::Contains, 1);
+	const FStagingBuffer Missing = FImportUtils::LoadDatFileIntoArray(FPaths::Combine(Dir, TEXT("Missing.dat")), 10);
+	TestFalse(TEXT("Buffer of a missing file is valid"), Missing.IsValid());
+
+	// A file shorter than the data described by its header must not be read at all
+	TArray<uint8> Data;
+	Data.SetNumZeroed(100);
+	const FString FileName = FPaths::Combine(Dir, TEXT("Short.dat"));
+	if (!TestTrue(TEXT("Data file written"), FFileHelper::SaveArrayToFile(Data, *FileName))) return false;
+	AddExpectedError(TEXT("does not have the expected size"), EAutomationExpectedErrorFlags::Contains, 1);
+	const FStagingBuffer Short = FImportUtils::LoadDatFileIntoArray(FileName, 101);
+	TestFalse(TEXT("Buffer of a short file is valid"), Short.IsValid());
+
+	// Exactly as many bytes as requested are fine
+	const FStagingBuffer Exact = FImportUtils::LoadDatFileIntoArray(FileName, 100);
+	TestTrue(TEXT("Buffer of a file of the requested size is valid"), Exact.IsValid());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConversionTest, "VRSmokeVis.ImportUtils.Conversion",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FConversionTest::RunTest(const FString& Parameters)
+{
+	// Beer-Lambert law with a step size of 0.001, rounded to the nearest integer
+	constexpr float ExtinctionCoefficient = 8.7f;
+	TestEqual(TEXT("Transmission of no density"), FImportUtils::GetTransmission(ExtinctionCoefficient, 0), 255);
+	TestEqual(TEXT("Transmission of density 100"), FImportUtils::GetTransmission(ExtinctionCoefficient, 100), 107);
+	TestEqual(TEXT("Transmission of density 255"), FImportUtils::GetTransmission(ExtinctionCoefficient, 255), 28);
+	for (int Density = 1; Density < 256; ++Density)
+	{
+		if (FImportUtils::GetTransmission(ExtinctionCoefficient, Density) >
+			FImportUtils::GetTransmission(ExtinctionCoefficient, Density - 1))
+		{
+			AddError(FString::Printf(TEXT("Transmission increases at density %d"), Density));
+			break;
+		}
+	}
+
+	// The lookup table has to produce the same values as converting each density on its own
+	TArray<uint8> Densities;
+	for (int Density = 0; Density < 256; ++Density) Densities.Add(Density);
+	TArray<uint8> Transmissions = Densities;
+	FImportUtils::DensityToTransmission(ExtinctionCoefficient, Transmissions.GetData(), Transmissions.Num());
+	for (int Density = 0; Density < 256; ++Density)
+	{
+		TestEqual(*FString::Printf(TEXT("Converted density %d"), Density), Transmissions[Density],
+		          FImportUtils::GetTransmission(ExtinctionCoefficient, Density));
+	}
+
+	// Statistics computed while converting describe the stored transmissions, so empty cells have a value of 255
+	uint8 Volume[] = {0, 0, 0, 0, 0, 0, 100, 0};
+	uint8 Conversion[256];
+	for (int Density = 0; Density < 256; ++Density)
+		Conversion[Density] = FImportUtils::GetTransmission(ExtinctionCoefficient, Density);
+	FDataStatistics Statistics;
+	FImportUtils::ComputeStatistics(Volume, FIntVector(2, 2, 1), 2, Statistics, Conversion);
+	TestEqual(TEXT("Converted while computing the statistics"), Volume[6], 107);
+	TestTrue(TEXT("Timestep without density is empty"),
+	         Statistics.IsTimeStepEmpty(0, UVolumeDataInfo::EmptyTransmission));
+	TestFalse(TEXT("Timestep with density is empty"),
+	          Statistics.IsTimeStepEmpty(1, UVolumeDataInfo::EmptyTransmission));
+	TestEqual(TEXT("Lowest transmission"), Statistics.TimeStepMins[1], 107);
+	TestEqual(TEXT("Histogram of the transmissions"), Statistics.Histogram[255], 7ll);
+
+	// A range of 127.5 is scaled by exactly 2, the fraction is cut off
+	uint8 Values[] = {64, 65, 100, 191};
+	FImportUtils::NormalizeArray(64.f, 191.5f, Values, UE_ARRAY_COUNT(Values));
+	TestEqual(TEXT("Normalized minimum"), Values[0], 0);
+	TestEqual(TEXT("Normalized value above the minimum"), Values[1], 2);
+	TestEqual(TEXT("Normalized value inside the range"), Values[2], 72);
+	TestEqual(TEXT("Normalized value below the maximum"), Values[3], 254);
+
+	uint8 Unchanged[] = {0, 17, 255};
+	FImportUtils::NormalizeArray(0.f, 255.f, Unchanged, UE_ARRAY_COUNT(Unchanged));
+	TestEqual(TEXT("Value normalized to its own range"), Unchanged[1], 17);
+	TestEqual(TEXT("Maximum normalized to its own range"), Unchanged[2], 255);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParseHeadersTest, "VRSmokeVis.ImportUtils.ParseHeaders",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FParseHeadersTest::RunTest(const FString& Parameters)
+{
+	const FString Dir = GetTestDir(TEXT("ParseHeaders"));
+	ON_SCOPE_EXIT { IFileManager::Get().DeleteDirectory(*Dir, false, true); };
+
+	// Headers as written by the preprocessor, all dimensions start with the number of timesteps
+	const FString VolumeFile = FPaths::Combine(Dir, TEXT("smoke.yaml"));
+	FFileHelper::SaveStringToFile(TEXT("DataValMax: 1.000000\nDataValMin: 0.000000\nMeshNum: 2\nMeshes:\n"
+		"- Mesh: 1\n  MeshPos: 0.000000 0.500000 1.000000\n  DimSize: 100 64 32 16\n"
+		"  Spacing: 0.250000 0.100000 0.200000 0.300000\n  DataFile: smoke_mesh-1.dat\n"
+		"- Mesh: 2\n  MeshPos: 6.400000 0.500000 1.000000\n  DimSize: 100 8 32 16\n"
+		"  Spacing: 0.250000 0.100000 0.200000 0.300000\n  DataFile: smoke_mesh-2.dat\n"
+		"Quantity: SOOT DENSITY\nScaleFactor: 255.000000\n"), *VolumeFile);
+	TMap<FString, UVolumeDataInfo*> VolumeInfos;
+	FImportUtils::ParseVolumeDataInfoFromFile(VolumeFile, VolumeInfos);
+	if (!TestEqual(TEXT("Number of volume meshes"), VolumeInfos.Num(), 2)) return false;
+	if (!TestTrue(TEXT("Volume meshes are found by their id"),
+	              VolumeInfos.Contains(TEXT("1")) && VolumeInfos.Contains(TEXT("2"))))
+		return false;
+	const UVolumeDataInfo* VolumeInfo = VolumeInfos[TEXT("2")];
+	TestEqual(TEXT("Volume dimensions"), VolumeInfo->Dimensions, FVector4(8, 32, 16, 100));
+	TestEqual(TEXT("Volume spacing"), VolumeInfo->Spacing, FVector4(.1, .2, .3, .25));
+	TestEqual(TEXT("Volume position"), VolumeInfo->MeshPos, FVector(6.4, .5, 1));
+	TestEqual(TEXT("Volume data file"), VolumeInfo->DataFileName, FString(TEXT("smoke_mesh-2.dat")));
+	TestEqual(TEXT("Volume quantity"), VolumeInfo->Quantity, FString(TEXT("soot density")));
+	TestEqual(TEXT("Volume minimum"), VolumeInfo->MinValue, 0.f);
+	TestEqual(TEXT("Volume maximum"), VolumeInfo->MaxValue, 1.f);
+	TestEqual(TEXT("Volume scale factor"), VolumeInfo->ScaleFactor, 255.f);
+	TestEqual(TEXT("Volume byte size"), VolumeInfo->GetByteSize(), 8ll * 32 * 16 * 100);
+
+	const FString SliceFile = FPaths::Combine(Dir, TEXT("slice.yaml"));
+	FFileHelper::SaveStringToFile(TEXT("CellCentered: 1\nDataValMax: 620.000000\nDataValMin: 20.000000\n"
+		"MeshNum: 1\nMeshes:\n- Mesh: 3\n  MeshPos: 0.000000 0.000000 1.600000\n  DimSize: 50 64 48 1\n"
+		"  Spacing: 0.500000 0.100000 0.200000 0.100000\n  DataFile: slice-1_mesh-3.dat\n"
+		"Quantity: TEMPERATURE\nScaleFactor: 0.425000\n"), *SliceFile);
+	TMap<FString, USliceDataInfo*> SliceInfos;
+	FImportUtils::ParseSliceDataInfoFromFile(SliceFile, SliceInfos);
+	if (!TestTrue(TEXT("Slice mesh is found by its id"), SliceInfos.Num() == 1 && SliceInfos.Contains(TEXT("3"))))
+		return false;
+	const USliceDataInfo* SliceInfo = SliceInfos[TEXT("3")];
+	TestTrue(TEXT("Slice is cell centered"), SliceInfo->CellCentered);
+	TestEqual(TEXT("Slice dimensions"), SliceInfo->Dimensions, FVector4(64, 48, 1, 50));
+	TestEqual(TEXT("Slice spacing"), SliceInfo->Spacing, FVector4(.1, .2, .1, .5));
+	TestEqual(TEXT("Slice quantity"), SliceInfo->Quantity, FString(TEXT("temperature")));
+	TestEqual(TEXT("Slice minimum"), SliceInfo->MinValue, 20.f);
+	TestEqual(TEXT("Slice maximum"), SliceInfo->MaxValue, 620.f);
+	TestEqual(TEXT("Slice scale factor"), SliceInfo->ScaleFactor, .425f);
+
+	const FString ObstFile = FPaths::Combine(Dir, TEXT("obst.yaml"));
+	FFileHelper::SaveStringToFile(TEXT("BoundingBox: 0.100000 0.500000 0.200000 0.600000 0.000000 0.300000\n"
+		"NumOrientations: 2\nNumQuantities: 1\nOrientations:\n"
+		"- BoundaryOrientation: -1\n  DimSize: 4 3\n  Spacing: 0.500000 0.100000 0.200000\n"
+		"- BoundaryOrientation: 3\n  DimSize: 4 2\n  Spacing: 0.500000 0.100000 0.200000\n"
+		"Quantities:\n- BoundaryQuantity: WALL TEMPERATURE\n  DataFile: obst-1_wall_temperature.dat\n"
+		"  DataValMax: 620.000000\n  DataValMin: 20.000000\n  ScaleFactor: 0.425000\nTimeSteps: 50\n"), *ObstFile);
+	UBoundaryDataInfo* ObstInfo = NewObject<UBoundaryDataInfo>();
+	TArray<float> BoundingBox;
+	FImportUtils::ParseObstDataInfoFromFile(ObstFile, ObstInfo, BoundingBox);
+	TestEqual(TEXT("Bounding box"), BoundingBox, TArray<float>({.1f, .5f, .2f, .6f, 0.f, .3f}));
+	if (!TestTrue(TEXT("Faces are found by their orientation"),
+	              ObstInfo->Dimensions.Num() == 2 && ObstInfo->Dimensions.Contains(-1) &&
+	              ObstInfo->Dimensions.Contains(3)))
+		return false;
+	TestEqual(TEXT("Face dimensions"), ObstInfo->Dimensions[3], FVector4(4, 2, 0, 50));
+	TestEqual(TEXT("Face spacing"), ObstInfo->Spacings[3], FVector4(.1f, .2f, 0, .5f));
+	TestEqual(TEXT("Obstruction data file"), ObstInfo->DataFileNames.FindRef(TEXT("wall temperature")),
+	          FString(TEXT("obst-1_wall_temperature.dat")));
+	TestEqual(TEXT("Obstruction minimum"), ObstInfo->MinValues.FindRef(TEXT("wall temperature")), 20.f);
+	TestEqual(TEXT("Obstruction maximum"), ObstInfo->MaxValues.FindRef(TEXT("wall temperature")), 620.f);
+	TestEqual(TEXT("Obstruction scale factor"), ObstInfo->ScaleFactors.FindRef(TEXT("wall temperature")), .425f);
+	TestEqual(TEXT("Obstruction byte size"), ObstInfo->GetByteSize(), (4ll * 3 + 4 * 2) * 50);
+
+	const FString SimulationFile = FPaths::Combine(Dir, TEXT("sim-smv.yaml"));
+	FFileHelper::SaveStringToFile(TEXT("Hash: 0123abcd\nNumObstructions: 1\nNumSlices: 1\nNumVolumes: 2\n"
+		"Obstructions:\n- obst.yaml\nSlices:\n- slice.yaml\nVolumes:\n- smoke.yaml\n- soot.yaml\n"), *SimulationFile);
+	USimulationInfo* SimInfo = NewObject<USimulationInfo>();
+	FImportUtils::ParseSimulationInfoFromFile(SimulationFile, SimInfo);
+	TestEqual(TEXT("Simulation hash"), SimInfo->Hash, FString(TEXT("0123abcd")));
+	TestEqual(TEXT("Hash read without parsing the whole file"), FImportUtils::GetSimulationHashFromFile(SimulationFile),
+	          SimInfo->Hash);
+	TestEqual(TEXT("Obstruction paths"), SimInfo->ObstPaths, TArray<FString>({TEXT("obst.yaml")}));
+	TestEqual(TEXT("Slice paths"), SimInfo->SlicePaths, TArray<FString>({TEXT("slice.yaml")}));
+	TestEqual(TEXT("Volume paths"), SimInfo->VolumePaths, TArray<FString>({TEXT("smoke.yaml"), TEXT("soot.yaml")}));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoadAndConvertLargeDatFileTest, "VRSmokeVis.ImportUtils.LoadAndConvertLargeDatFile",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+bool FLoadAndConvertLargeDatFileTest::RunTest(const FString& Parameters)
+{
+	const FString Dir = GetTestDir(TEXT("LoadAndConvertLargeDatFile"));
+	ON_SCOPE_EXIT { IFileManager::Get().DeleteDirectory(*Dir, false, true); };
+
+	// 33 timesteps of 1024x1024x64 voxels are larger than 2 GB, so neither the file offsets nor the indices of the
+	// conversion fit into an int32
+	FSyntheticDataSettings Settings;
+	Settings.MeshResolution = FIntVector(1024, 1024, 64);
+	Settings.NumTimeSteps = 33;
+	Settings.NumObstructions = 0;
+	Settings.NumSlices = 0;
+	Settings.NumVolumes = 1;
+	const FString SimulationFile = FSyntheticDataGenerator::GenerateSimulation(Settings, Dir);
+	if (!TestFalse(TEXT("Synthetic simulation generated"), SimulationFile.IsEmpty())) return false;
+
+	TMap<FString, UVolumeDataInfo*> DataInfos;
+	FImportUtils::ParseVolumeDataInfoFromFile(FPaths::Combine(Dir, TEXT("smoke-1.yaml")), DataInfos);
+	if (!TestEqual(TEXT("Number of meshes"), DataInfos.Num(), 1)) return false;
+	const UVolumeDataInfo* DataInfo = DataInfos.CreateConstIterator().Value();
+	const int64 ByteSize = DataInfo->GetByteSize();
+	if (!TestTrue(TEXT("Data is larger than MAX_int32"), ByteSize > MAX_int32)) return false;
+	const FString DataFile = FPaths::Combine(Dir, DataInfo->DataFileName);
+
+	// The beginning, the bytes around the int32 limit and the end of the data are compared with the file
+	constexpr int64 RangeSize = 256 * 1024;
+	const int64 Offsets[] = {0, MAX_int32 - RangeSize / 2, ByteSize - RangeSize};
+	TArray<TArray<uint8>> Expected;
+	for (const int64 Offset : Offsets)
+	{
+		Expected.Add(ReadFileRange(DataFile, Offset, RangeSize));
+		const int64 NumRead = Expected.Last().Num();
+		if (!TestEqual(TEXT("Bytes read directly from the file"), NumRead, RangeSize)) return false;
+	}
+
+	FStagingBuffer Loaded = FImportUtils::LoadDatFileIntoArray(DataFile, ByteSize);
+	if (!TestTrue(TEXT("Buffer is valid"), Loaded.IsValid())) return false;
+	for (int r = 0; r < UE_ARRAY_COUNT(Offsets); ++r)
+	{
+		TestEqual(*FString::Printf(TEXT("Loaded bytes at offset %lld"), Offsets[r]),
+		          FMemory::Memcmp(Loaded.GetData() + Offsets[r], Expected[r].GetData(), RangeSize), 0);
+	}
+
+	// Every byte has to be converted, including the ones past the int32 limit
+	constexpr float ExtinctionCoefficient = 8.7f;
+	FImportUtils::DensityToTransmission(ExtinctionCoefficient, Loaded.GetData(), ByteSize);
+	for (int r = 0; r < UE_ARRAY_COUNT(Offsets); ++r)
+	{
+		for (int64 i = 0; i < RangeSize; ++i)
+		{
+			const uint8 Transmission = FImportUtils::GetTransmission(ExtinctionCoefficient, Expected[r][i]);
+			if (Loaded.GetData()[Offsets[r] + i] != Transmission)
+			{
+				AddError(FString::Printf(TEXT("Byte %lld has not been converted to its transmission"),
+				                         Offsets[r] + i));
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoadAndConvertVolumeInTexturesTest,
+                                 "VRSmokeVis.ImportUtils.LoadAndConvertVolumeInTextures",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+bool FLoadAndConvertVolumeInTexturesTest::RunTest(const FString& Parameters)
+{
+	const FString Dir = GetTestDir(TEXT("LoadAndConvertVolumeInTextures"));
+	ON_SCOPE_EXIT { IFileManager::Get().DeleteDirectory(*Dir, false, true); };
+
+	// 33 timesteps of 1024x1024x128 voxels are larger than 4 GB, but are read four timesteps (512 MB) at a time
+	FSyntheticDataSettings Settings;
+	Settings.MeshResolution = FIntVector(1024, 1024, 128);
+	Settings.NumTimeSteps = 33;
+	Settings.NumObstructions = 0;
+	Settings.NumSlices = 0;
+	Settings.NumVolumes = 1;
+	const FString SimulationFile = FSyntheticDataGenerator::GenerateSimulation(Settings, Dir);
+	if (!TestFalse(TEXT("Synthetic simulation generated"), SimulationFile.IsEmpty())) return false;
+
+	TMap<FString, UVolumeDataInfo*> DataInfos;
+	FImportUtils::ParseVolumeDataInfoFromFile(FPaths::Combine(Dir, TEXT("smoke-1.yaml")), DataInfos);
+	if (!TestEqual(TEXT("Number of meshes"), DataInfos.Num(), 1)) return false;
+	UVolumeDataInfo* DataInfo = DataInfos.CreateConstIterator().Value();
+	DataInfo->TimeStepsPerTexture = 4;
+	const int64 ByteSize = DataInfo->GetByteSize();
+	if (!TestTrue(TEXT("Data is larger than MAX_uint32"), ByteSize > MAX_uint32)) return false;
+	const FString DataFile = FPaths::Combine(Dir, DataInfo->DataFileName);
+
+	// The beginning of each texture is compared with the converted bytes of the file at the same offset
+	constexpr int64 RangeSize = 256 * 1024;
+	constexpr float ExtinctionCoefficient = 8.7f;
+	const int64 UsedBytesBefore = FStagingBufferPool::Get().GetStats().UsedBytes;
+	int NextTextureIndex = 0;
+	int64 Offset = 0;
+	FDataStatistics Statistics;
+	const bool bLoaded = FImportUtils::LoadAndConvertVolumeData(
+		ExtinctionCoefficient, DataFile, DataInfo, [&](const int TextureIndex, uint8* Data, const int64 NumBytes)
+		{
+			TestEqual(TEXT("Textures are loaded in order"), TextureIndex, NextTextureIndex++);
+			TestEqual(*FString::Printf(TEXT("Byte size of texture %d"), TextureIndex), NumBytes,
+			          DataInfo->GetTextureByteSize(TextureIndex));
+			TestTrue(TEXT("Only a single texture is held in memory"),
+			         FStagingBufferPool::Get().GetStats().UsedBytes - UsedBytesBefore < 2 * NumBytes);
+
+			const TArray<uint8> Expected = ReadFileRange(DataFile, Offset, RangeSize);
+			if (!TestEqual(TEXT("Bytes read directly from the file"), Expected.Num(), static_cast<int>(RangeSize)))
+				return false;
+			for (int64 i = 0; i < RangeSize; ++i)
+			{
+				if (Data[i] != FImportUtils::GetTransmission(ExtinctionCoefficient, Expected[i]))
+				{
+					AddError(FString::Printf(TEXT("Byte %lld has not been converted to its transmission"), Offset + i));
+					return false;
+				}
+			}
+			Offset += NumBytes;
+			return true;
+		}, &Statistics);
+
+	TestTrue(TEXT("All textures loaded"), bLoaded);
+	TestEqual(TEXT("Number of textures"), NextTextureIndex, DataInfo->GetNumTextures());
+	TestEqual(TEXT("Bytes loaded"), Offset, ByteSize);
+
+	// The statistics of the textures are appended to those of all timesteps, including their bricks
+	TestEqual(TEXT("Timesteps of the statistics"), Statistics.GetNumTimeSteps(), DataInfo->GetNumTimeSteps());
+	TestEqual(TEXT("Bricks of the statistics"), Statistics.BrickMins.Num(),
+	          Statistics.NumBricks.X * Statistics.NumBricks.Y * Statistics.NumBricks.Z * DataInfo->GetNumTimeSteps());
+	int64 NumValues = 0;
+	for (const int64 Count : Statistics.Histogram) NumValues += Count;
+	TestEqual(TEXT("Values in the histogram"), NumValues, ByteSize);
+	return true;
+}
+
+#endif
@@ -0,0 +1,144 @@
+// Automation tests of the textures kept loaded during playback and of seeking and starting over
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Util/PlaybackWindow.h"
+
+
+/** Plays back NumRounds rounds of NumTimeSteps timesteps the way ASimulation::LoadUnloadTimeStep streams them and
+ * checks that exactly the textures of the previous timestep up to the last prefetched one are loaded at each step */
+static void TestPlaybackWindow(FAutomationTestBase& Test, const int NumTimeSteps, const int TimeStepsPerTexture,
+                               const int NumRounds)
+{
+	TSet<int> LoadedTextures;
+	for (int i = 0; i < FPlaybackWindow::GetNumInitialTimeSteps(NumTimeSteps); ++i)
+		LoadedTextures.Add(FPlaybackWindow::GetTextureIndex(i, TimeStepsPerTexture));
+
+	int TimeStep = 0;
+	for (int Step = 0; Step < NumRounds * NumTimeSteps; ++Step)
+	{
+		TimeStep = (TimeStep + 1) % NumTimeSteps;
+		const int UnloadTimeStep = FPlaybackWindow::GetUnloadTimeStep(TimeStep, NumTimeSteps);
+		if (FPlaybackWindow::ShouldUnloadTexture(UnloadTimeStep, TimeStepsPerTexture, NumTimeSteps))
+			LoadedTextures.Remove(FPlaybackWindow::GetTextureIndex(UnloadTimeStep, TimeStepsPerTexture));
+		const int PrefetchTimeStep = FPlaybackWindow::GetPrefetchTimeStep(TimeStep, NumTimeSteps);
+		if (FPlaybackWindow::ShouldRequestTexture(PrefetchTimeStep, TimeStepsPerTexture))
+			LoadedTextures.Add(FPlaybackWindow::GetTextureIndex(PrefetchTimeStep, TimeStepsPerTexture));
+
+		TSet<int> WindowTextures;
+		for (int i = -1; i <= FPlaybackWindow::PrefetchDistance; ++i)
+		{
+			WindowTextures.Add(FPlaybackWindow::GetTextureIndex((TimeStep + i + NumTimeSteps) % NumTimeSteps,
+			                                                    TimeStepsPerTexture));
+		}
+		if (WindowTextures.Difference(LoadedTextures).Num() > 0)
+		{
+			Test.AddError(FString::Printf(TEXT("Texture of the window not loaded at timestep %d of %d (%d per "
+			                                   "texture)"), TimeStep, NumTimeSteps, TimeStepsPerTexture));
+			return;
+		}
+		if (LoadedTextures.Difference(WindowTextures).Num() > 0)
+		{
+			Test.AddError(FString::Printf(TEXT("Texture outside of the window loaded at timestep %d of %d (%d per "
+			                                   "texture)"), TimeStep, NumTimeSteps, TimeStepsPerTexture));
+			return;
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlaybackWindowTest, "VRSmokeVis.PlaybackWindow.PrefetchAndUnload",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPlaybackWindowTest::RunTest(const FString& Parameters)
+{
+	// Both ends of the window wrap around
+	TestEqual(TEXT("Prefetched timestep"), FPlaybackWindow::GetPrefetchTimeStep(3, 20), 12);
+	TestEqual(TEXT("Prefetched timestep past the end"), FPlaybackWindow::GetPrefetchTimeStep(15, 20), 4);
+	TestEqual(TEXT("Unloaded timestep"), FPlaybackWindow::GetUnloadTimeStep(5, 20), 3);
+	TestEqual(TEXT("Unloaded timestep before the beginning"), FPlaybackWindow::GetUnloadTimeStep(0, 20), 18);
+	TestEqual(TEXT("Initial timesteps"), FPlaybackWindow::GetNumInitialTimeSteps(20), 10);
+	TestEqual(TEXT("Initial timesteps of a short simulation"), FPlaybackWindow::GetNumInitialTimeSteps(4), 4);
+
+	// Texture arrays are requested for their first and unloaded after their last timestep, the last one is not full
+	TestTrue(TEXT("Array requested for its first timestep"), FPlaybackWindow::ShouldRequestTexture(8, 4));
+	TestFalse(TEXT("Array requested for a later timestep"), FPlaybackWindow::ShouldRequestTexture(9, 4));
+	TestTrue(TEXT("Array unloaded after its last timestep"), FPlaybackWindow::ShouldUnloadTexture(11, 4, 18));
+	TestFalse(TEXT("Array unloaded after an earlier timestep"), FPlaybackWindow::ShouldUnloadTexture(12, 4, 18));
+	TestTrue(TEXT("Last array unloaded after the last timestep"), FPlaybackWindow::ShouldUnloadTexture(17, 4, 18));
+
+	TestPlaybackWindow(*this, 20, 1, 3);
+	TestPlaybackWindow(*this, 18, 4, 3);
+	TestPlaybackWindow(*this, 41, 8, 3);
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlaybackWindowSeekTest, "VRSmokeVis.PlaybackWindow.Seek",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPlaybackWindowSeekTest::RunTest(const FString& Parameters)
+{
+	// NextTimeStep advances by one after seeking, so the returned timesteps are one before the target
+	TestEqual(TEXT("Fast-forward"), FPlaybackWindow::GetFastForwardTimeStep(10, 3.f), 12);
+	TestEqual(TEXT("Fractional fast-forward"), FPlaybackWindow::GetFastForwardTimeStep(10, 3.7f), 12);
+	TestEqual(TEXT("Negative fast-forward"), FPlaybackWindow::GetFastForwardTimeStep(10, -5.f), 9);
+	TestTrue(TEXT("Fast-forward by the largest float is past the end without overflowing"),
+	         FPlaybackWindow::GetFastForwardTimeStep(10, TNumericLimits<float>::Max()) > 10);
+
+	TestEqual(TEXT("Rewind"), FPlaybackWindow::GetRewindTimeStep(10, 3.f), 6);
+	TestEqual(TEXT("Rewind past the beginning"), FPlaybackWindow::GetRewindTimeStep(5, 20.f), -1);
+	TestEqual(TEXT("Rewind by the largest float"), FPlaybackWindow::GetRewindTimeStep(10, TNumericLimits<float>::Max()),
+	          -1);
+	TestEqual(TEXT("Negative rewind"), FPlaybackWindow::GetRewindTimeStep(10, -5.f), 9);
+	TestEqual(TEXT("Rewind after starting over"), FPlaybackWindow::GetRewindTimeStep(-1, 20.f), -1);
+
+	// After rewinding to the first timestep, the window wraps around at its beginning
+	const int TimeStep = FPlaybackWindow::GetRewindTimeStep(5, 20.f) + 1;
+	TestEqual(TEXT("Unloaded timestep after rewinding"), FPlaybackWindow::GetUnloadTimeStep(TimeStep, 20), 18);
+	TestEqual(TEXT("Prefetched timestep after rewinding"), FPlaybackWindow::GetPrefetchTimeStep(TimeStep, 20), 9);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlaybackWindowStartOverTest, "VRSmokeVis.PlaybackWindow.StartOver",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPlaybackWindowStartOverTest::RunTest(const FString& Parameters)
+{
+	TMap<FString, int> TimeSteps = {{TEXT("Obst"), 2}, {TEXT("Slice"), 4}, {TEXT("Volume"), 9}};
+	const TMap<FString, int> NumTimeSteps = {{TEXT("Obst"), 5}, {TEXT("Slice"), 10}, {TEXT("Volume"), 10}};
+	TMap<FString, TArray<int>> SkippedTimeSteps;
+	const auto SkipTimeStep = [&SkippedTimeSteps](const FString& Type, const int TimeStep)
+	{
+		SkippedTimeSteps.FindOrAdd(Type).Add(TimeStep);
+	};
+
+	TestFalse(TEXT("Started over before the end"), FPlaybackWindow::AdvanceTimeStep(
+		          TEXT("Obst"), TimeSteps, NumTimeSteps, SkipTimeStep));
+	TestFalse(TEXT("Started over at the last timestep"), FPlaybackWindow::AdvanceTimeStep(
+		          TEXT("Obst"), TimeSteps, NumTimeSteps, SkipTimeStep));
+	TestEqual(TEXT("Last timestep"), TimeSteps[TEXT("Obst")], 4);
+	TestEqual(TEXT("Other types are not advanced"), TimeSteps[TEXT("Slice")], 4);
+	TestEqual(TEXT("No timesteps skipped before the end"), SkippedTimeSteps.Num(), 0);
+
+	// The first type reaching its end makes all of them start over, the others skip their remaining timesteps
+	TestTrue(TEXT("Started over past the end"), FPlaybackWindow::AdvanceTimeStep(
+		         TEXT("Obst"), TimeSteps, NumTimeSteps, SkipTimeStep));
+	TestEqual(TEXT("Timestep of the type reaching its end"), TimeSteps[TEXT("Obst")], 0);
+	TestEqual(TEXT("Timestep of another type"), TimeSteps[TEXT("Slice")], -1);
+	TestEqual(TEXT("Timestep of another type at its last timestep"), TimeSteps[TEXT("Volume")], -1);
+	TestFalse(TEXT("Timesteps of the type reaching its end skipped"), SkippedTimeSteps.Contains(TEXT("Obst")));
+	TestEqual(TEXT("Skipped timesteps"), SkippedTimeSteps.FindRef(TEXT("Slice")), TArray<int>({4, 5, 6, 7, 8, 9}));
+	TestEqual(TEXT("Skipped timesteps of a type at its last timestep"), SkippedTimeSteps.FindRef(TEXT("Volume")),
+	          TArray<int>({9}));
+
+	// The other timers fire at once, so all types show their first timestep again
+	TestFalse(TEXT("Started over again"), FPlaybackWindow::AdvanceTimeStep(
+		          TEXT("Slice"), TimeSteps, NumTimeSteps, SkipTimeStep));
+	FPlaybackWindow::AdvanceTimeStep(TEXT("Volume"), TimeSteps, NumTimeSteps, SkipTimeStep);
+	TestEqual(TEXT("Resynchronized slice"), TimeSteps[TEXT("Slice")], 0);
+	TestEqual(TEXT("Resynchronized volume"), TimeSteps[TEXT("Volume")], 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,44 @@
+// Automation tests of the size classes of the staging buffer pool
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Util/StagingBufferPool.h"
+
+
+/** Returns the number of bytes the pool hands out for a buffer of the given size */
+static int64 GetAcquiredBytes(const int64 Size)
+{
+	const int64 UsedBytesBefore = FStagingBufferPool::Get().GetStats().UsedBytes;
+	const FStagingBuffer Buffer(Size);
+	return FStagingBufferPool::Get().GetStats().UsedBytes - UsedBytesBefore;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStagingBufferPoolSizeClassesTest, "VRSmokeVis.StagingBufferPool.SizeClasses",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStagingBufferPoolSizeClassesTest::RunTest(const FString& Parameters)
+{
+	constexpr int64 MiB = 1024 * 1024;
+	TestEqual(TEXT("Smallest bucket"), GetAcquiredBytes(100), FStagingBufferPool::MinBucketSize);
+	TestEqual(TEXT("Power of two bucket"), GetAcquiredBytes(MiB + 1), 2 * MiB);
+	TestEqual(TEXT("Largest power of two bucket"), GetAcquiredBytes(2 * MiB), 2 * MiB);
+
+	// Larger buffers are rounded up to an eighth of the power of two below them
+	TestEqual(TEXT("Size class above the largest power of two bucket"), GetAcquiredBytes(2 * MiB + 1),
+	          2 * MiB + MiB / 4);
+	TestEqual(TEXT("Size class just above a power of two"), GetAcquiredBytes(17 * MiB), 18 * MiB);
+	TestEqual(TEXT("Size class just below a power of two"), GetAcquiredBytes(63 * MiB), 64 * MiB);
+	TestEqual(TEXT("Exact size class"), GetAcquiredBytes(40 * MiB), 40 * MiB);
+
+	// Buffers of the same size class share their bucket
+	GetAcquiredBytes(17 * MiB + 4096);
+	const int64 NumHitsBefore = FStagingBufferPool::Get().GetStats().NumHits;
+	GetAcquiredBytes(17 * MiB + 8192);
+	TestEqual(TEXT("Buffer of the same size class reused"), FStagingBufferPool::Get().GetStats().NumHits,
+	          NumHitsBefore + 1);
+	return true;
+}
+
+#endif
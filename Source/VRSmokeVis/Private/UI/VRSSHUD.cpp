@@ -2,8 +2,13 @@
 
 #include "Actor/VRSSMotionController.h"
 #include "UI/UserInterfaceUserWidget.h"
+#include "VRSSGameInstanceSubsystem.h"
 
 
+static TAutoConsoleVariable<bool> CVarShowMemoryUsage(
+	TEXT("VRSmokeVis.ShowMemoryUsage"), false,
+	TEXT("Shows the CPU and GPU memory used by each simulation and type on the HUD"));
+
 AVRSSHUD::AVRSSHUD()
 {
 }
@@ -11,6 +16,36 @@ AVRSSHUD::AVRSSHUD()
 void AVRSSHUD::DrawHUD()
 {
 	Super::DrawHUD();
+
+	if (CVarShowMemoryUsage.GetValueOnGameThread()) DrawMemoryUsage();
+}
+
+void AVRSSHUD::DrawMemoryUsage()
+{
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastMemoryUsageUpdateTime >= MemoryUsageUpdateInterval)
+	{
+		LastMemoryUsageUpdateTime = Now;
+		MemoryUsageLines.Reset();
+		const UVRSSGameInstanceSubsystem* GI = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>();
+		for (const FSimulationMemoryUsage& Usage : GI->GetMemoryUsage())
+		{
+			MemoryUsageLines.Add(FString::Printf(TEXT("%s: %.1f MB CPU, %.1f MB GPU"), *Usage.SimulationName,
+			                                     Usage.Total.CpuBytes / (1024.f * 1024.f),
+			                                     Usage.Total.GpuBytes / (1024.f * 1024.f)));
+			for (const TPair<FString, FVRSSMemoryUsage>& TypeUsage : Usage.PerType)
+				MemoryUsageLines.Add(FString::Printf(TEXT("    %s: %.1f MB CPU, %.1f MB GPU"), *TypeUsage.Key,
+				                                     TypeUsage.Value.CpuBytes / (1024.f * 1024.f),
+				                                     TypeUsage.Value.GpuBytes / (1024.f * 1024.f)));
+		}
+	}
+
+	float Y = 50;
+	for (const FString& Line : MemoryUsageLines)
+	{
+		DrawText(Line, FLinearColor::White, 50, Y);
+		Y += 15;
+	}
 }
 
 void AVRSSHUD::BeginPlay()
@@ -6,11 +6,17 @@
 #include "Assets/ObstAsset.h"
 #include "Assets/SimulationAsset.h"
 #include "Containers/UnrealString.h"
-#include "Engine/ObjectLibrary.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/VolumeTexture.h"
 #include "UObject/SavePackage.h"
 #include "Util/ImportUtilities.h"
 #include "Util/Preprocessor.h"
+#include "Util/StagingBufferPool.h"
+#include "VRSSConfig.h"
+#include "VRSSStats.h"
+#include "Assets/FdsTimeSeriesAsset.h"
+#include "HAL/PlatformFileManager.h"
+#include "ProfilingDebugging/ScopedTimers.h"
 
 
 DEFINE_LOG_CATEGORY(LogAssetUtils)
@@ -61,26 +67,19 @@ UObject* FAssetCreationUtils::CreateSimulation(const FString& InFileName, const
 
 	FString NewHash = FImportUtils::GetSimulationHashFromFile(SimulationIntermediateFile);
 
-	TArray<FAssetData> SimulationInfos;
-	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(USimulationInfo::StaticClass(), false, GIsEditor);
-	ObjectLibrary->AddToRoot();
-	ObjectLibrary->LoadAssetDataFromPath(OutDirectory);
-	ObjectLibrary->GetAssetDataList(SimulationInfos);
-	if (SimulationInfos.Num() > 0)
+	// The names of the simulation (info) assets are fixed, so there is no need to scan the output directory for them
+	const FString SimInfoPackageName = FPaths::Combine(OutDirectory, "SI_" + SimName);
+	if (FPackageName::DoesPackageExist(SimInfoPackageName))
 	{
-		const FString OldHash = Cast<USimulationInfo>(
-			FStreamableManager().LoadSynchronous(SimulationInfos[0].ToSoftObjectPath()))->Hash;
+		const USimulationInfo* OldSimInfo = Cast<USimulationInfo>(
+			FStreamableManager().LoadSynchronous(FSoftObjectPath(SimInfoPackageName + ".SI_" + SimName)));
 
 		// If the old hash equals the new hash, we don't have to continue here and simply use the already loaded simulation
-		if (OldHash.Equals(NewHash))
+		if (OldSimInfo && OldSimInfo->Hash.Equals(NewHash))
 		{
-			TArray<FAssetData> SimulationAssets;
-			ObjectLibrary = UObjectLibrary::CreateLibrary(USimulationAsset::StaticClass(), false, GIsEditor);
-			ObjectLibrary->AddToRoot();
-			ObjectLibrary->LoadAssetDataFromPath(OutDirectory);
-			ObjectLibrary->GetAssetDataList(SimulationAssets);
-			if (SimulationInfos.Num() > 0)
-				return FStreamableManager().LoadSynchronous(SimulationAssets[0].ToSoftObjectPath());
+			const FString SimPackageName = FPaths::Combine(OutDirectory, SimName);
+			UObject* OldSimAsset = FStreamableManager().LoadSynchronous(FSoftObjectPath(SimPackageName + "." + SimName));
+			if (OldSimAsset) return OldSimAsset;
 		}
 	}
 
@@ -104,8 +103,10 @@ UObject* FAssetCreationUtils::CreateSimulation(const FString& InFileName, const
 		for (FString& ObstPath : SimInfo->ObstPaths)
 		{
 			FString ObstFullPath = FPaths::Combine(Directory, ObstPath);
-			LoadAndCreateObstruction(ObstsPackagePath, ObstFullPath, LazyLoad);
+			LoadAndCreateObstruction(ObstsPackagePath, ObstFullPath, LazyLoad, SimAsset->Obstructions);
 		}
+		if (GetDefault<UVRSSConfig>()->ShouldPackObstAtlas())
+			CreateObstAtlas(SimAsset, ObstsPackagePath, SimName);
 	}
 
 	if (SimInfo->SlicePaths.Num() != 0)
@@ -118,7 +119,7 @@ UObject* FAssetCreationUtils::CreateSimulation(const FString& InFileName, const
 		for (FString& SlicePath : SimInfo->SlicePaths)
 		{
 			FString SliceFullPath = FPaths::Combine(Directory, SlicePath);
-			LoadSlice(SlicesPackagePath, SliceFullPath, LazyLoad);
+			LoadSlice(SlicesPackagePath, SliceFullPath, LazyLoad, SimAsset->Slices);
 		}
 	}
 
@@ -132,7 +133,7 @@ UObject* FAssetCreationUtils::CreateSimulation(const FString& InFileName, const
 		for (FString& VolumePath : SimInfo->VolumePaths)
 		{
 			FString VolumeFullPath = FPaths::Combine(Directory, VolumePath);
-			LoadVolumes(VolumesPackagePath, VolumeFullPath, LazyLoad);
+			LoadVolumes(VolumesPackagePath, VolumeFullPath, LazyLoad, SimAsset->Volumes);
 		}
 	}
 
@@ -142,19 +143,39 @@ UObject* FAssetCreationUtils::CreateSimulation(const FString& InFileName, const
 	// Save DataInfo to disk
 	FString PackageFileName = FPackageName::LongPackageNameToFilename(
 		SimInfo->GetPackage()->GetName(), FPackageName::GetAssetPackageExtension());
-	UPackage::Save(SimInfo->GetPackage(), SimInfo, *PackageFileName, SavePackageArgs);
+	SavePackage(SimInfo->GetPackage(), SimInfo, *PackageFileName, SavePackageArgs);
 	FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().AssetCreated(SimInfo);
 	SimAsset->SimInfo = SimInfo;
 
 	PackageFileName = FPackageName::LongPackageNameToFilename(
 		SimAsset->GetPackage()->GetName(), FPackageName::GetAssetPackageExtension());
-	UPackage::Save(SimAsset->GetPackage(), SimAsset, *PackageFileName, SavePackageArgs);
+	SavePackage(SimAsset->GetPackage(), SimAsset, *PackageFileName, SavePackageArgs);
+
+	// The import buffers are not needed anymore until the next import
+	const FStagingBufferPoolStats PoolStats = FStagingBufferPool::Get().GetStats();
+	UE_LOG(LogAssetUtils, Log, TEXT("Staging buffer pool: %lld hits, %lld misses, %lld bytes pooled"), PoolStats.NumHits,
+	       PoolStats.NumMisses, PoolStats.PooledBytes);
+	FStagingBufferPool::Get().Trim();
+
+	const FImportStats& ImportStats = FImportUtils::GetImportStats();
+	UE_LOG(LogAssetUtils, Log,
+	       TEXT("Import times: parse %.2fs, read %.2fs (%lld bytes), convert %.2fs, texture creation %.2fs, save %.2fs"),
+	       ImportStats.ParseSeconds, ImportStats.ReadSeconds, ImportStats.BytesRead, ImportStats.ConvertSeconds,
+	       ImportStats.TextureCreateSeconds, ImportStats.SaveSeconds);
 
 	return SimAsset;
 }
 
+bool FAssetCreationUtils::SavePackage(UPackage* Package, UObject* Asset, const TCHAR* PackageFileName,
+                                      const FSavePackageArgs& SavePackageArgs)
+{
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_SavePackage);
+	FScopedDurationTimer SaveTimer(FImportUtils::GetImportStats().SaveSeconds);
+	return UPackage::Save(Package, Asset, PackageFileName, SavePackageArgs).IsSuccessful();
+}
+
 void FAssetCreationUtils::LoadAndCreateObstruction(const FString& RootPackage, const FString& FileName,
-                                                   const bool LazyLoad)
+                                                   const bool LazyLoad, TArray<FSoftObjectPath>& OutPaths)
 {
 	FSavePackageArgs SavePackageArgs;
 	SavePackageArgs.TopLevelFlags = RF_Standalone | RF_Public;
@@ -204,24 +225,145 @@ void FAssetCreationUtils::LoadAndCreateObstruction(const FString& RootPackage, c
 
 	if (!LazyLoad) LoadObstTextures(DataInfo);
 
+	ObstAsset->DataInfo = DataInfo;
+	// The texture names are deterministic, so the ordered tables can be written now, even if the textures are only
+	// created at a later point in time
+	CreateTexturePathTables(ObstAsset, "Obst");
+
 	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
 		"AssetRegistry");
 
 	// Save DataInfo to disk
 	FString PackageFileName = FPackageName::LongPackageNameToFilename(
 		DataInfo->GetPackage()->GetName(), FPackageName::GetAssetPackageExtension());
-	UPackage::Save(DataInfo->GetPackage(), DataInfo, *PackageFileName, SavePackageArgs);
+	SavePackage(DataInfo->GetPackage(), DataInfo, *PackageFileName, SavePackageArgs);
 	AssetRegistryModule.Get().AssetCreated(DataInfo);
-	ObstAsset->DataInfo = DataInfo;
 
 	// Save Obstruction to disk
 	PackageFileName = FPackageName::LongPackageNameToFilename(
 		ObstAsset->GetPackage()->GetName(), FPackageName::GetAssetPackageExtension());
-	UPackage::Save(ObstAsset->GetPackage(), ObstAsset, *PackageFileName, SavePackageArgs);
+	SavePackage(ObstAsset->GetPackage(), ObstAsset, *PackageFileName, SavePackageArgs);
 	AssetRegistryModule.Get().AssetCreated(ObstAsset);
+	OutPaths.Emplace(ObstAsset);
+}
+
+void FAssetCreationUtils::CreateObstAtlas(USimulationAsset* SimAsset, const FString& RootPackage,
+                                          const FString& SimName)
+{
+	FSavePackageArgs SavePackageArgs;
+	SavePackageArgs.TopLevelFlags = RF_Standalone | RF_Public;
+
+	// Collect the faces of all obstructions. The layout of the atlas is the same for all quantities, faces without data
+	// for a quantity simply stay empty
+	TArray<UObstAsset*> ObstAssets;
+	TArray<TPair<int, int>> Faces;
+	TArray<FIntPoint> FaceSizes;
+	TSet<FString> Quantities;
+	for (const FSoftObjectPath& ObstPath : SimAsset->Obstructions)
+	{
+		UObstAsset* ObstAsset = Cast<UObstAsset>(ObstPath.TryLoad());
+		const UBoundaryDataInfo* DataInfo = Cast<UBoundaryDataInfo>(ObstAsset->DataInfo);
+		for (const TPair<int, FVector4>& Dimension : DataInfo->Dimensions)
+		{
+			Faces.Emplace(ObstAssets.Num(), Dimension.Key);
+			FaceSizes.Emplace(Dimension.Value.X, Dimension.Value.Y);
+		}
+		for (const TPair<FString, FString>& DataFileName : DataInfo->DataFileNames)
+			Quantities.Add(DataFileName.Key);
+		ObstAssets.Add(ObstAsset);
+	}
+
+	TArray<FIntPoint> FaceOffsets;
+	const FIntPoint AtlasSize = FTextureUtils::PackAtlas(FaceSizes, FaceOffsets);
+	if (AtlasSize.X * AtlasSize.Y == 0) return;
+	if (AtlasSize.GetMax() > 16384)
+		UE_LOG(LogAssetUtils, Warning, TEXT("Obstruction atlas of %s has a size of %dx%d, which not all GPUs support"),
+		       *SimName, AtlasSize.X, AtlasSize.Y);
+
+	// Faces are stored one after another in the data file of an obstruction, each with all of its timesteps
+	TArray<int64> FaceDataOffsets;
+	FaceDataOffsets.SetNumUninitialized(Faces.Num());
+	int64 Offset = 0;
+	for (int f = 0; f < Faces.Num(); ++f)
+	{
+		if (f > 0 && Faces[f].Key != Faces[f - 1].Key) Offset = 0;
+		FaceDataOffsets[f] = Offset;
+		Offset += Cast<UBoundaryDataInfo>(ObstAssets[Faces[f].Key]->DataInfo)->GetByteSize(Faces[f].Value);
+
+		ObstAssets[Faces[f].Key]->AtlasRects.Add(Faces[f].Value, FVector4(
+			                                         static_cast<float>(FaceOffsets[f].X) / AtlasSize.X,
+			                                         static_cast<float>(FaceOffsets[f].Y) / AtlasSize.Y,
+			                                         static_cast<float>(FaceSizes[f].X) / AtlasSize.X,
+			                                         static_cast<float>(FaceSizes[f].Y) / AtlasSize.Y));
+	}
+
+	const int64 AtlasTextureSize = static_cast<int64>(AtlasSize.X) * AtlasSize.Y;
+	const FStagingBuffer AtlasBuffer(AtlasTextureSize);
+	uint8* AtlasData = AtlasBuffer.GetData();
+	for (const FString& Quantity : Quantities)
+	{
+		TArray<FStagingBuffer> ObstData;
+		ObstData.SetNum(ObstAssets.Num());
+		int NumTimeSteps = MAX_int32;
+		for (int i = 0; i < ObstAssets.Num(); ++i)
+		{
+			UBoundaryDataInfo* DataInfo = Cast<UBoundaryDataInfo>(ObstAssets[i]->DataInfo);
+			if (const FString* DataFileName = DataInfo->DataFileNames.Find(Quantity))
+			{
+				ObstData[i] = FImportUtils::LoadObstData(*DataFileName, DataInfo,
+				                                         &DataInfo->Statistics.FindOrAdd(Quantity));
+				for (const TPair<int, FVector4>& Dimension : DataInfo->Dimensions)
+					NumTimeSteps = FMath::Min(NumTimeSteps, static_cast<int>(Dimension.Value.W));
+			}
+		}
+
+		const FString TexturePrefix = "OAT_" + SimName + "_" + Quantity;
+		const FString TextureDir = FPaths::Combine(RootPackage, "Atlas", Quantity);
+		for (int t = 0; t < NumTimeSteps; ++t)
+		{
+			FMemory::Memzero(AtlasData, AtlasTextureSize);
+			for (int f = 0; f < Faces.Num(); ++f)
+			{
+				const uint8* FaceData = ObstData[Faces[f].Key].GetData();
+				if (!FaceData) continue;
+
+				const FIntPoint& Size = FaceSizes[f];
+				FaceData += FaceDataOffsets[f] + static_cast<int64>(t) * Size.X * Size.Y;
+				for (int y = 0; y < Size.Y; ++y)
+				{
+					FMemory::Memcpy(AtlasData + (FaceOffsets[f].Y + y) * static_cast<int64>(AtlasSize.X) + FaceOffsets[f].X,
+					                FaceData + static_cast<int64>(y) * Size.X, Size.X);
+				}
+			}
+
+			const FString TextureName = GetTextureName(TexturePrefix, t);
+			UPackage* SubPackage = CreatePackage(*FPaths::Combine(TextureDir, TextureName));
+			UTexture2D* AtlasTexture = FTextureUtils::CreateTextureAsset(
+				TextureName, FVector4(AtlasSize.X, AtlasSize.Y, 1, NumTimeSteps), SubPackage, AtlasData,
+				AtlasTextureSize);
+			FString PackageFileName = FPackageName::LongPackageNameToFilename(
+				SubPackage->GetName(), FPackageName::GetAssetPackageExtension());
+			SavePackage(SubPackage, AtlasTexture, *PackageFileName, SavePackageArgs);
+		}
+		FillTexturePaths(SimAsset->ObstAtlasTextures.FindOrAdd(Quantity).Textures, TextureDir, TexturePrefix,
+		                 NumTimeSteps);
+	}
+
+	// Save the obstructions again, as they now contain the position of their faces inside the atlas and the statistics
+	// of their data
+	for (UObstAsset* ObstAsset : ObstAssets)
+	{
+		FString PackageFileName = FPackageName::LongPackageNameToFilename(
+			ObstAsset->GetPackage()->GetName(), FPackageName::GetAssetPackageExtension());
+		SavePackage(ObstAsset->GetPackage(), ObstAsset, *PackageFileName, SavePackageArgs);
+		SaveDataInfo(ObstAsset->DataInfo);
+	}
+	UE_LOG(LogAssetUtils, Log, TEXT("Packed %d obstruction faces of %s into a %dx%d atlas for %d quantities"),
+	       Faces.Num(), *SimName, AtlasSize.X, AtlasSize.Y, Quantities.Num());
 }
 
-void FAssetCreationUtils::LoadSlice(const FString& RootPackage, const FString& FileName, const bool LazyLoad)
+void FAssetCreationUtils::LoadSlice(const FString& RootPackage, const FString& FileName, const bool LazyLoad,
+                                    TArray<FSoftObjectPath>& OutPaths)
 {
 	FSavePackageArgs SavePackageArgs;
 	SavePackageArgs.TopLevelFlags = RF_Standalone | RF_Public;
@@ -237,10 +379,8 @@ void FAssetCreationUtils::LoadSlice(const FString& RootPackage, const FString& F
 	FImportUtils::ParseSliceDataInfoFromFile(FileName, DataInfos);
 	for (auto It = DataInfos.CreateIterator(); It; ++It)
 	{
-		TArray<UTexture2D*> SliceTextures;
 		UPackage* SlicePackage = CreatePackage(*FPaths::Combine(RootPackage, It.Value()->ImportName));
 		USliceAsset* Slice = CreateSlice(It.Value(), FileName, SlicePackage, It.Key(), LazyLoad);
-		Slice->SliceTextures.Reserve(It.Value()->Dimensions.W);
 
 		// Copy DataInfo into correct package
 		UPackage* SliceDataInfoPackage = CreatePackage(*FPaths::Combine(RootPackage, "DataInfos", It.Value()->ImportName));
@@ -249,22 +389,29 @@ void FAssetCreationUtils::LoadSlice(const FString& RootPackage, const FString& F
 		                                                     RF_Standalone | RF_Public, It.Value());
 		DataInfo->DataFileName = FPaths::Combine(Directory, DataInfo->DataFileName);
 
-		// Save DataInfo to disk
+		Slice->DataInfo = DataInfo;
+		if (GetDefault<UVRSSConfig>()->ShouldWriteTimeSeries())
+			CreateTimeSeries(Slice, "Slice");
+		else
+			CreateTexturePathTables(Slice, "Slice");
+
+		// Save DataInfo to disk, after writing the time series as its statistics are computed while doing so
 		FString PackageFileName = FPackageName::LongPackageNameToFilename(
 			SliceDataInfoPackage->GetName(), FPackageName::GetAssetPackageExtension());
-		UPackage::Save(SliceDataInfoPackage, DataInfo, *PackageFileName, SavePackageArgs);
+		SavePackage(SliceDataInfoPackage, DataInfo, *PackageFileName, SavePackageArgs);
 		AssetRegistryModule.Get().AssetCreated(DataInfo);
-		Slice->DataInfo = DataInfo;
 
 		// Save Slice to disk
 		PackageFileName = FPackageName::LongPackageNameToFilename(
 			Slice->GetPackage()->GetName(), FPackageName::GetAssetPackageExtension());
-		UPackage::Save(Slice->GetPackage(), Slice, *PackageFileName, SavePackageArgs);
+		SavePackage(Slice->GetPackage(), Slice, *PackageFileName, SavePackageArgs);
 		AssetRegistryModule.Get().AssetCreated(Slice);
+		OutPaths.Emplace(Slice);
 	}
 }
 
-void FAssetCreationUtils::LoadVolumes(const FString& RootPackage, const FString& FileName, const bool LazyLoad)
+void FAssetCreationUtils::LoadVolumes(const FString& RootPackage, const FString& FileName, const bool LazyLoad,
+                                      TArray<FSoftObjectPath>& OutPaths)
 {
 	FSavePackageArgs SavePackageArgs;
 	SavePackageArgs.TopLevelFlags = RF_Standalone | RF_Public;
@@ -280,12 +427,9 @@ void FAssetCreationUtils::LoadVolumes(const FString& RootPackage, const FString&
 	FImportUtils::ParseVolumeDataInfoFromFile(FileName, DataInfos);
 	for (auto It = DataInfos.CreateIterator(); It; ++It)
 	{
-		TArray<UVolumeTexture*> VolumeTextures;
 		UPackage* VolumePackage = CreatePackage(*FPaths::Combine(RootPackage, It.Value()->ImportName));
 		UVolumeAsset* Volume = CreateVolume(It.Value(), FileName, VolumePackage, It.Key(), LazyLoad);
 
-		Volume->VolumeTextures.Reserve(It.Value()->Dimensions.W);
-
 		// Copy DataInfo into correct package
 		UPackage* VolumeDataInfoPackage =
 			CreatePackage(*FPaths::Combine(RootPackage, "DataInfos", It.Value()->ImportName));
@@ -295,18 +439,23 @@ void FAssetCreationUtils::LoadVolumes(const FString& RootPackage, const FString&
 		DataInfo->DataFileName = FPaths::Combine(Directory, DataInfo->DataFileName);
 
 		Volume->DataInfo = DataInfo;
+		if (GetDefault<UVRSSConfig>()->ShouldWriteTimeSeries())
+			CreateTimeSeries(Volume, "Volume");
+		else
+			CreateTexturePathTables(Volume, "Volume");
 		// Save DataInfo to disk
 		FString PackageFileName = FPackageName::LongPackageNameToFilename(
 			VolumeDataInfoPackage->GetName(), FPackageName::GetAssetPackageExtension());
-		UPackage::Save(VolumeDataInfoPackage, DataInfo, *PackageFileName, SavePackageArgs);
+		SavePackage(VolumeDataInfoPackage, DataInfo, *PackageFileName, SavePackageArgs);
 		AssetRegistryModule.Get().AssetCreated(DataInfo);
 
 		// Save Volume to disk
 		PackageFileName = FPackageName::LongPackageNameToFilename(Volume->GetPackage()->GetName(),
 		                                                          FPackageName::GetAssetPackageExtension());
-		UPackage::Save(Volume->GetPackage(), Volume, *PackageFileName, SavePackageArgs);
+		SavePackage(Volume->GetPackage(), Volume, *PackageFileName, SavePackageArgs);
 
 		AssetRegistryModule.Get().AssetCreated(Volume);
+		OutPaths.Emplace(Volume);
 	}
 }
 
@@ -326,7 +475,11 @@ USliceAsset* FAssetCreationUtils::CreateSlice(USliceDataInfo* DataInfo, const FS
 
 	// Setup Texture Dirs
 	DataInfo->TextureDir = FPaths::Combine(PackagePath.RightChop(8), DataInfo->ImportName + "_" + MeshName);
-	if (!LazyLoad) LoadSliceTextures(DataInfo);
+	// A single timestep per texture keeps the plain 2D textures instead of texture arrays
+	const int SliceTimeStepsPerTexture = GetDefault<UVRSSConfig>()->GetSliceTimeStepsPerTexture();
+	DataInfo->TimeStepsPerTexture = SliceTimeStepsPerTexture > 1 ? SliceTimeStepsPerTexture : 0;
+	// Time series are written once the DataInfo is complete and don't need any textures
+	if (!LazyLoad && !GetDefault<UVRSSConfig>()->ShouldWriteTimeSeries()) LoadSliceTextures(DataInfo);
 
 	return SliceAsset;
 }
@@ -347,7 +500,11 @@ UVolumeAsset* FAssetCreationUtils::CreateVolume(UVolumeDataInfo* DataInfo, const
 
 	// Setup Texture Dirs
 	DataInfo->TextureDir = FPaths::Combine(PackagePath.RightChop(8), MeshName);
-	if (!LazyLoad) LoadVolumeTextures(DataInfo);
+	// Volume textures may not be deeper than 2048 voxels on all platforms
+	DataInfo->TimeStepsPerTexture = FMath::Clamp(GetDefault<UVRSSConfig>()->GetVolumeTimeStepsPerTexture(), 1,
+	                                             FMath::Max(1, 2048 / static_cast<int>(DataInfo->Dimensions.Z)));
+	// Time series are written once the DataInfo is complete and don't need any textures
+	if (!LazyLoad && !GetDefault<UVRSSConfig>()->ShouldWriteTimeSeries()) LoadVolumeTextures(DataInfo);
 
 	return VolumeAsset;
 }
@@ -366,6 +523,153 @@ void FAssetCreationUtils::LoadTextures(UDataInfo* DataInfo, const FString& Type)
 	{
 		LoadVolumeTextures(Cast<UVolumeDataInfo>(DataInfo));
 	}
+	// The DataInfo has already been saved during the import, but the statistics are only known now
+	SaveDataInfo(DataInfo);
+}
+
+void FAssetCreationUtils::SaveDataInfo(UDataInfo* DataInfo)
+{
+	FSavePackageArgs SavePackageArgs;
+	SavePackageArgs.TopLevelFlags = RF_Standalone | RF_Public;
+	const FString PackageFileName = FPackageName::LongPackageNameToFilename(
+		DataInfo->GetPackage()->GetName(), FPackageName::GetAssetPackageExtension());
+	SavePackage(DataInfo->GetPackage(), DataInfo, *PackageFileName, SavePackageArgs);
+}
+
+FString FAssetCreationUtils::GetTextureName(const FString& TexturePrefix, const int TimeStep)
+{
+	return TexturePrefix + "_Data_t" + FString::FromInt(TimeStep);
+}
+
+void FAssetCreationUtils::FillTexturePaths(TArray<FSoftObjectPath>& TexturePaths, const FString& TextureDir,
+                                           const FString& TexturePrefix, const int NumTimeSteps)
+{
+	TexturePaths.Reset(NumTimeSteps);
+	for (int t = 0; t < NumTimeSteps; ++t)
+	{
+		const FString TextureName = GetTextureName(TexturePrefix, t);
+		TexturePaths.Emplace(FPaths::Combine(TextureDir, TextureName) + "." + TextureName);
+	}
+}
+
+void FAssetCreationUtils::CreateTexturePathTables(UFdsDataAsset* Asset, const FString& Type)
+{
+	if (Type == "Obst")
+	{
+		UObstAsset* ObstAsset = Cast<UObstAsset>(Asset);
+		const UBoundaryDataInfo* DataInfo = Cast<UBoundaryDataInfo>(Asset->DataInfo);
+		for (const TPair<FString, FQuantityDir>& TextureDir : DataInfo->TextureDirs)
+		{
+			FFixedQuantityObstTextures& QuantityTextures = ObstAsset->ObstTextures.FindOrAdd(TextureDir.Key);
+			for (const TPair<int, FString>& FaceDir : TextureDir.Value.FaceDirs)
+			{
+				const FString DirName = DataInfo->ImportName + "_" + TextureDir.Key + "_Face" +
+					FString::FromInt(FaceDir.Key);
+				FillTexturePaths(QuantityTextures.ForOrientation.FindOrAdd(FaceDir.Key).Textures, FaceDir.Value,
+				                 "OT_" + DirName, DataInfo->Dimensions[FaceDir.Key].W);
+			}
+		}
+	}
+	else if (Type == "Slice")
+	{
+		const USliceDataInfo* DataInfo = Cast<USliceDataInfo>(Asset->DataInfo);
+		if (DataInfo->TimeStepsPerTexture > 0)
+		{
+			FillTexturePaths(Cast<USliceAsset>(Asset)->SliceTextures, DataInfo->TextureDir,
+			                 "STA_" + DataInfo->ImportName,
+			                 FMath::DivideAndRoundUp(DataInfo->GetNumTimeSteps(), DataInfo->TimeStepsPerTexture));
+		}
+		else
+		{
+			FillTexturePaths(Cast<USliceAsset>(Asset)->SliceTextures, DataInfo->TextureDir,
+			                 "ST_" + DataInfo->ImportName, DataInfo->GetNumTimeSteps());
+		}
+	}
+	else
+	{
+		const UVolumeDataInfo* DataInfo = Cast<UVolumeDataInfo>(Asset->DataInfo);
+		FillTexturePaths(Cast<UVolumeAsset>(Asset)->VolumeTextures, DataInfo->TextureDir,
+		                 (DataInfo->GetTimeStepsPerTexture() > 1 ? "VTC_" : "VT_") + DataInfo->ImportName,
+		                 DataInfo->GetNumTextures());
+	}
+}
+
+void FAssetCreationUtils::CreateTimeSeries(UFdsDataAsset* Asset, const FString& Type)
+{
+	FIntVector Dimensions;
+	int NumTimeSteps;
+	FString TextureDir;
+	if (Type == "Slice")
+	{
+		const USliceDataInfo* DataInfo = Cast<USliceDataInfo>(Asset->DataInfo);
+		const FVector4 TextureDimensions = FTextureUtils::GetSliceTextureDimensions(DataInfo->Dimensions);
+		Dimensions = FIntVector(FMath::RoundToInt(TextureDimensions.X), FMath::RoundToInt(TextureDimensions.Y), 1);
+		NumTimeSteps = DataInfo->GetNumTimeSteps();
+		TextureDir = DataInfo->TextureDir;
+	}
+	else
+	{
+		const UVolumeDataInfo* DataInfo = Cast<UVolumeDataInfo>(Asset->DataInfo);
+		Dimensions = DataInfo->GetVoxelDimensions();
+		NumTimeSteps = DataInfo->GetNumTimeSteps();
+		TextureDir = DataInfo->TextureDir;
+	}
+
+	const FString TimeSeriesName = "TS_" + Asset->DataInfo->ImportName;
+	UFdsTimeSeriesAsset* TimeSeries = NewObject<UFdsTimeSeriesAsset>(Asset, FName(TimeSeriesName), RF_Public);
+	// TextureDir is a package path starting with /Game/, the sidecar files mirror it in their own directory
+	TimeSeries->DataFileName = FPaths::Combine(UFdsTimeSeriesAsset::DataDirectory, TextureDir.RightChop(6),
+	                                           TimeSeriesName + ".bin");
+	TimeSeries->Dimensions = Dimensions;
+
+	// All timesteps have the same size for now, the offset table however allows for differently sized timesteps
+	const int64 TimeStepSize = static_cast<int64>(Dimensions.X) * Dimensions.Y * Dimensions.Z;
+	TimeSeries->TimeStepOffsets.SetNumUninitialized(NumTimeSteps + 1);
+	for (int t = 0; t <= NumTimeSteps; ++t)
+		TimeSeries->TimeStepOffsets[t] = TimeStepSize * t;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString FilePath = TimeSeries->GetDataFilePath();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+	TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*FilePath));
+	const auto WriteData = [&FileHandle](const uint8* Data, const int64 NumBytes)
+	{
+		VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_SavePackage);
+		FScopedDurationTimer SaveTimer(FImportUtils::GetImportStats().SaveSeconds);
+		return FileHandle->Write(Data, NumBytes);
+	};
+
+	// Volumes are read, converted and written one texture at a time, so files larger than the memory can be imported
+	bool bWritten = false;
+	if (FileHandle && Type == "Slice")
+	{
+		USliceDataInfo* DataInfo = Cast<USliceDataInfo>(Asset->DataInfo);
+		const FStagingBuffer LoadedArray = FImportUtils::LoadSliceData(DataInfo->DataFileName, DataInfo,
+		                                                               &DataInfo->Statistics);
+		bWritten = LoadedArray.IsValid() && WriteData(LoadedArray.GetData(), TimeSeries->TimeStepOffsets.Last());
+	}
+	else if (FileHandle)
+	{
+		UVolumeDataInfo* DataInfo = Cast<UVolumeDataInfo>(Asset->DataInfo);
+		bWritten = FImportUtils::LoadAndConvertVolumeData(
+			1, DataInfo->DataFileName, DataInfo, [&WriteData](int, const uint8* Data, const int64 NumBytes)
+			{
+				return WriteData(Data, NumBytes);
+			}, &DataInfo->Statistics);
+	}
+	FileHandle.Reset();
+
+	if (bWritten)
+	{
+		Asset->TimeSeries = TimeSeries;
+	}
+	else
+	{
+		// Don't leave a partially written time series behind
+		PlatformFile.DeleteFile(*FilePath);
+		UE_LOG(LogAssetUtils, Error, TEXT("Could not write the time series of %s to %s"),
+		       *Asset->DataInfo->ImportName, *FilePath);
+	}
 }
 
 void FAssetCreationUtils::LoadObstTextures(UBoundaryDataInfo* DataInfo)
@@ -379,8 +683,10 @@ void FAssetCreationUtils::LoadObstTextures(UBoundaryDataInfo* DataInfo)
 	for (const auto DataFileName : DataInfo->DataFileNames)
 	{
 		FString Quantity = DataFileName.Key;
-		uint8* LoadedArray = FImportUtils::LoadObstData(DataFileName.Value, DataInfo);
-		int Offset = 0;
+		const FStagingBuffer LoadedArray = FImportUtils::LoadObstData(DataFileName.Value, DataInfo,
+		                                                              &DataInfo->Statistics.FindOrAdd(Quantity));
+		if (!LoadedArray.IsValid()) continue;
+		int64 Offset = 0;
 
 		// Set pointer to current data position at timestep t for each orientation
 		for (const int Ori : Orientations)
@@ -388,79 +694,106 @@ void FAssetCreationUtils::LoadObstTextures(UBoundaryDataInfo* DataInfo)
 			const FString DirName = DataInfo->ImportName + "_" + Quantity + "_Face" + FString::FromInt(Ori);
 			for (int t = 0; t < DataInfo->Dimensions[Ori].W; ++t)
 			{
-				const long SingleTextureSize = static_cast<long>(DataInfo->Dimensions[Ori].X) * DataInfo->Dimensions[
-						Ori].
-					Y;
-				const FString FaceTextureName = "OT_" + DirName + "_Data_t" + FString::FromInt(t);
+				const int64 SingleTextureSize = DataInfo->GetTimeStepByteSize(Ori);
+				const FString FaceTextureName = GetTextureName("OT_" + DirName, t);
 				UPackage* SubPackage = CreatePackage(
 					*FPaths::Combine(DataInfo->TextureDirs[Quantity].FaceDirs[Ori], FaceTextureName));
 				UTexture2D* ObstTexture = FTextureUtils::CreateTextureAsset(FaceTextureName, DataInfo->Dimensions[Ori],
-				                                                            SubPackage, LoadedArray + Offset,
+				                                                            SubPackage, LoadedArray.GetData() + Offset,
 				                                                            SingleTextureSize);
 				ObstTexture->Filter = TF_Default;
 				FString PackageFileName = FPackageName::LongPackageNameToFilename(
 					SubPackage->GetName(), FPackageName::GetAssetPackageExtension());
-				UPackage::Save(SubPackage, ObstTexture, *PackageFileName, SavePackageArgs);
+				SavePackage(SubPackage, ObstTexture, *PackageFileName, SavePackageArgs);
 
 				Offset += SingleTextureSize;
 			}
 		}
-		FMemory::Free(LoadedArray);
 	}
 }
 
 void FAssetCreationUtils::LoadSliceTextures(USliceDataInfo* DataInfo)
 {
-	uint8* LoadedArray = FImportUtils::LoadSliceData(DataInfo->DataFileName, DataInfo);
+	const FStagingBuffer LoadedArray = FImportUtils::LoadSliceData(DataInfo->DataFileName, DataInfo,
+	                                                               &DataInfo->Statistics);
+	if (!LoadedArray.IsValid()) return;
 
 	FSavePackageArgs SavePackageArgs;
 	SavePackageArgs.TopLevelFlags = RF_Standalone | RF_Public;
+	const int64 SingleTextureSize = DataInfo->GetTotalCells();
+	// Create the persistent slice texture arrays, each layer containing the data of a single timestep. The number in
+	// the name of each texture array is the index of the array, not the timestep
+	if (DataInfo->TimeStepsPerTexture > 0)
+	{
+		const int NumTimeSteps = DataInfo->GetNumTimeSteps();
+		for (int i = 0, t = 0; t < NumTimeSteps; ++i, t += DataInfo->TimeStepsPerTexture)
+		{
+			const int NumLayers = FMath::Min(DataInfo->TimeStepsPerTexture, NumTimeSteps - t);
+			const FString SliceTextureName = GetTextureName("STA_" + DataInfo->ImportName, i);
+			UPackage* SubPackage = CreatePackage(*FPaths::Combine(DataInfo->TextureDir, SliceTextureName));
+
+			UTexture2DArray* SliceTexture = FTextureUtils::CreateSliceTextureArrayAsset(
+				SliceTextureName, FVector4(DataInfo->Dimensions.X, DataInfo->Dimensions.Y, DataInfo->Dimensions.Z,
+				                           NumLayers), SubPackage,
+				LoadedArray.GetData() + SingleTextureSize * t, SingleTextureSize * NumLayers);
+
+			FString PackageFileName = FPackageName::LongPackageNameToFilename(
+				SubPackage->GetName(), FPackageName::GetAssetPackageExtension());
+			SavePackage(SubPackage, SliceTexture, *PackageFileName, SavePackageArgs);
+		}
+		return;
+	}
+
 	// Create the persistent slice textures.
-	for (int t = 0; t < DataInfo->Dimensions.W; ++t)
+	for (int t = 0; t < DataInfo->GetNumTimeSteps(); ++t)
 	{
-		const long SingleTextureSize = static_cast<long>(DataInfo->Dimensions.X) * DataInfo->Dimensions.Y * DataInfo
-			->Dimensions.Z;
-		const FString SliceTextureName = "ST_" + DataInfo->ImportName + "_Data_t" + FString::FromInt(t);
+		const FString SliceTextureName = GetTextureName("ST_" + DataInfo->ImportName, t);
 		UPackage* SubPackage = CreatePackage(*FPaths::Combine(DataInfo->TextureDir, SliceTextureName));
 
 		// Set pointer to current slice position at timestep t
 		UTexture2D* SliceTexture = FTextureUtils::CreateSliceTextureAsset(
 			SliceTextureName, DataInfo->Dimensions, SubPackage,
-			LoadedArray + SingleTextureSize * t, SingleTextureSize);
+			LoadedArray.GetData() + SingleTextureSize * t, SingleTextureSize);
 
 		FString PackageFileName = FPackageName::LongPackageNameToFilename(
 			SubPackage->GetName(), FPackageName::GetAssetPackageExtension());
-		UPackage::Save(SubPackage, SliceTexture, *PackageFileName, SavePackageArgs);
+		SavePackage(SubPackage, SliceTexture, *PackageFileName, SavePackageArgs);
 	}
-
-	delete[] LoadedArray;
 }
 
 void FAssetCreationUtils::LoadVolumeTextures(UVolumeDataInfo* DataInfo)
 {
-	uint8* LoadedArray = FImportUtils::LoadAndConvertVolumeData(1, DataInfo->DataFileName, DataInfo);
-
 	FSavePackageArgs SavePackageArgs;
 	SavePackageArgs.TopLevelFlags = RF_Standalone | RF_Public;
-	const long SingleTextureSize = static_cast<long>(DataInfo->Dimensions.X) * DataInfo->Dimensions.Y * DataInfo->
-		Dimensions.Z;
-	// Create the persistent volume textures
-	for (int t = 0; t < DataInfo->Dimensions.W; ++t)
-	{
-		const FString VolumeTextureName = "VT_" + DataInfo->ImportName + "_Data_t" + FString::FromInt(t);
-		UPackage* SubPackage = CreatePackage(*FPaths::Combine(DataInfo->TextureDir, VolumeTextureName));
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Create the persistent volume textures. Consecutive timesteps are stored right after each other in the data, so
+	// a texture containing multiple timesteps simply stacks them along the z-axis. The number in the name of each
+	// texture is the index of the texture, which only equals the timestep if each texture contains a single one.
+	// Each texture is saved before the data of the next one is read, so only a single texture is held in memory
+	const int TimeStepsPerTexture = DataInfo->GetTimeStepsPerTexture();
+	const FString TexturePrefix = (TimeStepsPerTexture > 1 ? "VTC_" : "VT_") + DataInfo->ImportName;
+	const int NumTextures = DataInfo->GetNumTextures();
+	const bool bLoaded = FImportUtils::LoadAndConvertVolumeData(
+		1, DataInfo->DataFileName, DataInfo, [&](const int TextureIndex, uint8* Data, const int64 NumBytes)
+		{
+			FVector4 TextureDimensions = DataInfo->Dimensions;
+			TextureDimensions.Z *= DataInfo->GetNumStackedTimeSteps(TextureIndex);
 
-		// Set pointer to current Volume position at timestep t
-		UVolumeTexture* VolumeTexture = FTextureUtils::CreateVolumeAsset(
-			VolumeTextureName, DataInfo->Dimensions, SubPackage,
-			LoadedArray + SingleTextureSize * t,
-			SingleTextureSize);
-		VolumeTexture->Filter = TF_Bilinear;
+			const FString VolumeTextureName = GetTextureName(TexturePrefix, TextureIndex);
+			UPackage* SubPackage = CreatePackage(*FPaths::Combine(DataInfo->TextureDir, VolumeTextureName));
 
-		FString PackageFileName = FPackageName::LongPackageNameToFilename(
-			SubPackage->GetName(), FPackageName::GetAssetPackageExtension());
-		UPackage::Save(Cast<UPackage>(SubPackage), VolumeTexture, *PackageFileName, SavePackageArgs);
-	}
+			UVolumeTexture* VolumeTexture = FTextureUtils::CreateVolumeAsset(
+				VolumeTextureName, TextureDimensions, SubPackage, Data, NumBytes);
+			VolumeTexture->Filter = TF_Bilinear;
+
+			FString PackageFileName = FPackageName::LongPackageNameToFilename(
+				SubPackage->GetName(), FPackageName::GetAssetPackageExtension());
+			SavePackage(Cast<UPackage>(SubPackage), VolumeTexture, *PackageFileName, SavePackageArgs);
+			return true;
+		}, &DataInfo->Statistics);
+	if (!bLoaded) return;
 
-	delete[] LoadedArray;
+	UE_LOG(LogAssetUtils, Log, TEXT("Created %d volume textures (%d timesteps each) for %s in %.2fs"), NumTextures,
+	       TimeStepsPerTexture, *DataInfo->ImportName, FPlatformTime::Seconds() - StartTime);
 }
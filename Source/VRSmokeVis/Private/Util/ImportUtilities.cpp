@@ -7,9 +7,12 @@
 #include "Assets/SliceDataInfo.h"
 #include "Assets/VolumeDataInfo.h"
 #include "Assets/SimulationInfo.h"
+#include "Util/StagingBufferPool.h"
 #include "HAL/FileManagerGeneric.h"
 #include "Misc/DefaultValueHelper.h"
 #include "Misc/FileHelper.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+#include "VRSSStats.h"
 
 
 DEFINE_LOG_CATEGORY(LogImportUtils);
@@ -53,27 +56,45 @@ void FImportUtils::SplitPath(const FString& FullPath, FString& OutFilePath, FStr
 	OutFilename = FPaths::MakeValidFileName(OutFilename);
 }
 
-uint8* FImportUtils::LoadDatFileIntoArray(const FString FileName, const int64 BytesToLoad)
+/** ParallelFor only supports int32 indices, arrays larger than 2 GB are therefore processed in chunks */
+template <typename FunctionType>
+static void ParallelForEachByte(const int64 NumBytes, const FunctionType& Function)
 {
+	constexpr int64 ChunkSize = 64 * 1024;
+	ParallelFor(FMath::DivideAndRoundUp(NumBytes, ChunkSize), [&](const int Chunk)
+	{
+		const int64 End = FMath::Min(NumBytes, (Chunk + 1) * ChunkSize);
+		for (int64 Idx = Chunk * ChunkSize; Idx < End; ++Idx) Function(Idx);
+	});
+}
+
+FStagingBuffer FImportUtils::LoadDatFileIntoArray(const FString FileName, const int64 BytesToLoad, const int64 Offset)
+{
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_ReadData);
+	FScopedDurationTimer ReadTimer(GetImportStats().ReadSeconds);
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	IFileHandle* FileHandle = PlatformFile.OpenRead(*FileName);
+	const TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenRead(*FileName));
 	if (!FileHandle)
 	{
 		UE_LOG(LogImportUtils, Error, TEXT("Data file %s could not be opened."), *FileName);
-		return nullptr;
+		return FStagingBuffer();
 	}
-	if (FileHandle->Size() < BytesToLoad)
+	if (FileHandle->Size() < Offset + BytesToLoad)
 	{
 		UE_LOG(LogImportUtils, Error,
-		       TEXT("Data file %s does not have the expected size of (at least) %d bytes, aborting."), *FileName,
-		       BytesToLoad);
-		delete FileHandle;
-		return nullptr;
+		       TEXT("Data file %s does not have the expected size of (at least) %lld bytes, aborting."), *FileName,
+		       Offset + BytesToLoad);
+		return FStagingBuffer();
 	}
 
-	uint8* LoadedArray = static_cast<uint8*>(FMemory::Malloc(BytesToLoad));
-	FileHandle->Read(LoadedArray, BytesToLoad);
-	delete FileHandle;
+	FStagingBuffer LoadedArray(BytesToLoad);
+	if (!FileHandle->Seek(Offset) || !FileHandle->Read(LoadedArray.GetData(), BytesToLoad))
+	{
+		UE_LOG(LogImportUtils, Error, TEXT("Could not read %lld bytes at offset %lld from data file %s."), BytesToLoad,
+		       Offset, *FileName);
+		return FStagingBuffer();
+	}
+	GetImportStats().BytesRead += BytesToLoad;
 
 	return LoadedArray;
 }
@@ -81,61 +102,203 @@ uint8* FImportUtils::LoadDatFileIntoArray(const FString FileName, const int64 By
 void FImportUtils::DensityToTransmission(const float ExtinctionCoefficient, const UVolumeDataInfo* DataInfo,
                                          uint8* Array)
 {
-	// Uses the Beer-Lambert law to convert densities to the corresponding transmission using the extinction coefficient
-	// Adding 0.5 before assigning the float value to the uint8 array causes it to round correctly without having to
-	// round manually, as the implicit conversion to an integer simply cuts off the fraction.
-	float StepSize = 0.001;
+	DensityToTransmission(ExtinctionCoefficient, Array, DataInfo->GetByteSize());
+}
+
+void FImportUtils::DensityToTransmission(const float ExtinctionCoefficient, uint8* Array, const int64 NumBytes)
+{
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Convert);
+	FScopedDurationTimer ConvertTimer(GetImportStats().ConvertSeconds);
 
-	// Multiply StepSize and extinction coefficient only once before looping over the array
-	StepSize *= ExtinctionCoefficient * -1;
+	// There are only 256 different densities, so each transmission is only computed once
+	uint8 Transmissions[256];
+	for (int Density = 0; Density < 256; ++Density)
+		Transmissions[Density] = GetTransmission(ExtinctionCoefficient, Density);
 
-	ParallelFor(DataInfo->GetByteSize(), [&](const int Idx)
+	ParallelForEachByte(NumBytes, [&](const int64 Idx)
 	{
-		Array[Idx] = FMath::Exp(StepSize * Array[Idx]) * 255.f + .5f;
+		Array[Idx] = Transmissions[Array[Idx]];
 	});
 }
 
+uint8 FImportUtils::GetTransmission(const float ExtinctionCoefficient, const uint8 Density)
+{
+	// Uses the Beer-Lambert law to convert densities to the corresponding transmission using the extinction coefficient
+	// Adding 0.5 before assigning the float value to the uint8 causes it to round correctly without having to round
+	// manually, as the implicit conversion to an integer simply cuts off the fraction.
+	constexpr float StepSize = 0.001;
+	return FMath::Exp(StepSize * ExtinctionCoefficient * -1 * Density) * 255.f + .5f;
+}
+
 void FImportUtils::NormalizeArray(const UVolumeDataInfo* DataInfo, uint8* Array)
 {
-	const float ValueRange = 255.f / (DataInfo->MaxValue - DataInfo->MinValue);
-	ParallelFor(DataInfo->GetByteSize(), [&](const int Idx)
+	NormalizeArray(DataInfo->MinValue, DataInfo->MaxValue, Array, DataInfo->GetByteSize());
+}
+
+void FImportUtils::NormalizeArray(const float MinValue, const float MaxValue, uint8* Array, const int64 NumBytes)
+{
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Convert);
+	FScopedDurationTimer ConvertTimer(GetImportStats().ConvertSeconds);
+	const float ValueRange = 255.f / (MaxValue - MinValue);
+	ParallelForEachByte(NumBytes, [&](const int64 Idx)
 	{
-		Array[Idx] = (Array[Idx] - DataInfo->MinValue) * ValueRange;
+		Array[Idx] = (Array[Idx] - MinValue) * ValueRange;
 	});
 }
 
-uint8* FImportUtils::LoadAndConvertVolumeData(const float ExtinctionCoefficient, const FString& FilePath,
-                                              const UVolumeDataInfo* DataInfo)
+void FImportUtils::ComputeStatistics(uint8* Data, const FIntVector& Dimensions, const int NumTimeSteps,
+                                     FDataStatistics& OutStatistics, const uint8* Conversion)
 {
-	// Load data
-	uint8* LoadedArray = LoadDatFileIntoArray(FilePath, DataInfo->GetByteSize());
-	if (LoadedArray)
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Convert);
+	FScopedDurationTimer ConvertTimer(GetImportStats().ConvertSeconds);
+	OutStatistics = FDataStatistics();
+	if (Dimensions.X <= 0 || Dimensions.Y <= 0 || Dimensions.Z <= 0 || NumTimeSteps <= 0) return;
+
+	const FIntVector BrickSize(FMath::Min(Dimensions.X, FDataStatistics::MaxBrickSize),
+	                           FMath::Min(Dimensions.Y, FDataStatistics::MaxBrickSize),
+	                           FMath::Min(Dimensions.Z, FDataStatistics::MaxBrickSize));
+	const FIntVector NumBricks(FMath::DivideAndRoundUp(Dimensions.X, BrickSize.X),
+	                           FMath::DivideAndRoundUp(Dimensions.Y, BrickSize.Y),
+	                           FMath::DivideAndRoundUp(Dimensions.Z, BrickSize.Z));
+	const int BricksPerTimeStep = NumBricks.X * NumBricks.Y * NumBricks.Z;
+	const int64 TimeStepSize = static_cast<int64>(Dimensions.X) * Dimensions.Y * Dimensions.Z;
+
+	OutStatistics.BrickSize = BrickSize;
+	OutStatistics.NumBricks = NumBricks;
+	OutStatistics.BrickMins.SetNumUninitialized(BricksPerTimeStep * NumTimeSteps);
+	OutStatistics.BrickMaxs.SetNumUninitialized(BricksPerTimeStep * NumTimeSteps);
+	OutStatistics.Histogram.Init(0, 256);
+
+	// Each brick of each timestep is processed on its own, only the histogram is shared between them
+	ParallelFor(BricksPerTimeStep * NumTimeSteps, [&](const int Index)
+	{
+		const int Brick = Index % BricksPerTimeStep;
+		const FIntVector Start = FIntVector(Brick % NumBricks.X, Brick / NumBricks.X % NumBricks.Y,
+		                                    Brick / (NumBricks.X * NumBricks.Y)) * BrickSize;
+		const FIntVector End(FMath::Min(Start.X + BrickSize.X, Dimensions.X),
+		                     FMath::Min(Start.Y + BrickSize.Y, Dimensions.Y),
+		                     FMath::Min(Start.Z + BrickSize.Z, Dimensions.Z));
+		uint8* TimeStepData = Data + Index / BricksPerTimeStep * TimeStepSize;
+
+		uint8 Min = 255, Max = 0;
+		uint32 Histogram[256] = {};
+		for (int z = Start.Z; z < End.Z; ++z)
+		{
+			for (int y = Start.Y; y < End.Y; ++y)
+			{
+				uint8* Row = TimeStepData + (static_cast<int64>(z) * Dimensions.Y + y) * Dimensions.X;
+				for (int x = Start.X; x < End.X; ++x)
+				{
+					const uint8 Value = Conversion ? Conversion[Row[x]] : Row[x];
+					Min = FMath::Min(Min, Value);
+					Max = FMath::Max(Max, Value);
+					++Histogram[Value];
+					if (Conversion) Row[x] = Value;
+				}
+			}
+		}
+
+		OutStatistics.BrickMins[Index] = Min;
+		OutStatistics.BrickMaxs[Index] = Max;
+		for (int Value = 0; Value < 256; ++Value)
+			if (Histogram[Value] > 0) FPlatformAtomics::InterlockedAdd(&OutStatistics.Histogram[Value], Histogram[Value]);
+	});
+
+	OutStatistics.TimeStepMins.Init(255, NumTimeSteps);
+	OutStatistics.TimeStepMaxs.Init(0, NumTimeSteps);
+	for (int t = 0; t < NumTimeSteps; ++t)
 	{
-		DensityToTransmission(ExtinctionCoefficient, DataInfo, LoadedArray);
+		for (int Brick = t * BricksPerTimeStep; Brick < (t + 1) * BricksPerTimeStep; ++Brick)
+		{
+			OutStatistics.TimeStepMins[t] = FMath::Min(OutStatistics.TimeStepMins[t], OutStatistics.BrickMins[Brick]);
+			OutStatistics.TimeStepMaxs[t] = FMath::Max(OutStatistics.TimeStepMaxs[t], OutStatistics.BrickMaxs[Brick]);
+		}
 	}
-	return LoadedArray;
 }
 
-uint8* FImportUtils::LoadSliceData(const FString& FilePath, const USliceDataInfo* DataInfo)
+bool FImportUtils::LoadAndConvertVolumeData(
+	const float ExtinctionCoefficient, const FString& FilePath, const UVolumeDataInfo* DataInfo,
+	const TFunctionRef<bool(int TextureIndex, uint8* Data, int64 NumBytes)> OnTextureLoaded,
+	FDataStatistics* OutStatistics)
 {
-	return LoadDatFileIntoArray(FilePath, DataInfo->GetByteSize());
+	// The size is checked up front, so a truncated file doesn't leave the textures of its first timesteps behind
+	const int64 FileSize = FPlatformFileManager::Get().GetPlatformFile().FileSize(*FilePath);
+	if (FileSize < DataInfo->GetByteSize())
+	{
+		UE_LOG(LogImportUtils, Error,
+		       TEXT("Data file %s could not be opened or is smaller than the expected %lld bytes, aborting."),
+		       *FilePath, DataInfo->GetByteSize());
+		return false;
+	}
+
+	uint8 Transmissions[256];
+	for (int Density = 0; Density < 256; ++Density)
+		Transmissions[Density] = GetTransmission(ExtinctionCoefficient, Density);
+	if (OutStatistics) *OutStatistics = FDataStatistics();
+
+	// The buffer of each texture is returned to the staging buffer pool before the next one is read, so all textures
+	// but the last one, which may contain fewer timesteps, reuse the same memory
+	int64 Offset = 0;
+	for (int i = 0; i < DataInfo->GetNumTextures(); ++i)
+	{
+		const int64 TextureByteSize = DataInfo->GetTextureByteSize(i);
+		FStagingBuffer LoadedArray = LoadDatFileIntoArray(FilePath, TextureByteSize, Offset);
+		if (!LoadedArray.IsValid()) return false;
+
+		if (OutStatistics)
+		{
+			FDataStatistics TextureStatistics;
+			ComputeStatistics(LoadedArray.GetData(), DataInfo->GetVoxelDimensions(),
+			                  DataInfo->GetNumStackedTimeSteps(i), TextureStatistics, Transmissions);
+			OutStatistics->Append(TextureStatistics);
+		}
+		else
+		{
+			DensityToTransmission(ExtinctionCoefficient, LoadedArray.GetData(), TextureByteSize);
+		}
+
+		if (!OnTextureLoaded(i, LoadedArray.GetData(), TextureByteSize)) return false;
+		Offset += TextureByteSize;
+	}
+	return true;
 }
 
-uint8* FImportUtils::LoadObstData(const FString& FilePath, const UBoundaryDataInfo* DataInfo)
+FStagingBuffer FImportUtils::LoadSliceData(const FString& FilePath, const USliceDataInfo* DataInfo,
+                                           FDataStatistics* OutStatistics)
 {
-	int TotalByteSize = 0;
-	TArray<int> Orientations;
-	DataInfo->Dimensions.GetKeys(Orientations);
-	for (const int Orientation : Orientations)
+	FStagingBuffer LoadedArray = LoadDatFileIntoArray(FilePath, DataInfo->GetByteSize());
+	if (LoadedArray.IsValid() && OutStatistics)
+		ComputeStatistics(LoadedArray.GetData(), DataInfo->GetCellDimensions(), DataInfo->GetNumTimeSteps(),
+		                  *OutStatistics);
+	return LoadedArray;
+}
+
+FStagingBuffer FImportUtils::LoadObstData(const FString& FilePath, const UBoundaryDataInfo* DataInfo,
+                                          FDataStatistics* OutStatistics)
+{
+	// The faces are stored one after another, summed up as int64 as boundary files may be larger than 2 GB
+	FStagingBuffer LoadedArray = LoadDatFileIntoArray(FilePath, DataInfo->GetByteSize());
+	if (!LoadedArray.IsValid() || !OutStatistics) return LoadedArray;
+
+	*OutStatistics = FDataStatistics();
+	int64 Offset = 0;
+	for (const TPair<int, FVector4>& Dimension : DataInfo->Dimensions)
 	{
-		TotalByteSize += DataInfo->GetByteSize(Orientation);
+		FDataStatistics FaceStatistics;
+		ComputeStatistics(LoadedArray.GetData() + Offset,
+		                  FIntVector(FMath::RoundToInt(Dimension.Value.X), FMath::RoundToInt(Dimension.Value.Y), 1),
+		                  FMath::RoundToInt(Dimension.Value.W), FaceStatistics);
+		OutStatistics->Merge(FaceStatistics);
+		Offset += DataInfo->GetByteSize(Dimension.Key);
 	}
-	return LoadDatFileIntoArray(FilePath, TotalByteSize);
+	return LoadedArray;
 }
 
 void FImportUtils::ParseVolumeDataInfoFromFile(const FString& FileName,
                                                UPARAM(ref) TMap<FString, UVolumeDataInfo*>& DataInfos)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Parse);
+	FScopedDurationTimer ParseTimer(GetImportStats().ParseSeconds);
 	const FString FileString = ReadFileAsString(FileName);
 	TArray<FString> Lines;
 	FileString.ParseIntoArray(Lines, _T("\n"));
@@ -238,6 +401,8 @@ void FImportUtils::ParseVolumeDataInfoFromFile(const FString& FileName,
 void FImportUtils::ParseSliceDataInfoFromFile(const FString& FileName,
                                               UPARAM(ref) TMap<FString, USliceDataInfo*>& DataInfos)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Parse);
+	FScopedDurationTimer ParseTimer(GetImportStats().ParseSeconds);
 	const FString FileString = ReadFileAsString(FileName);
 	TArray<FString> Lines;
 	FileString.ParseIntoArray(Lines, _T("\n"));
@@ -346,6 +511,8 @@ void FImportUtils::ParseSliceDataInfoFromFile(const FString& FileName,
 void FImportUtils::ParseObstDataInfoFromFile(const FString& FilePath, UPARAM(ref) UBoundaryDataInfo* DataInfo,
                                              UPARAM(ref) TArray<float>& BoundingBoxOut)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Parse);
+	FScopedDurationTimer ParseTimer(GetImportStats().ParseSeconds);
 	const FString FileString = ReadFileAsString(FilePath);
 	TArray<FString> Lines;
 	FileString.ParseIntoArray(Lines, _T("\n"));
@@ -452,6 +619,8 @@ void FImportUtils::ParseObstDataInfoFromFile(const FString& FilePath, UPARAM(ref
 
 void FImportUtils::ParseSimulationInfoFromFile(const FString& FileName, UPARAM(ref) USimulationInfo* SimInfo)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_Parse);
+	FScopedDurationTimer ParseTimer(GetImportStats().ParseSeconds);
 	SimInfo->SmokeViewOriginalFilePath = FileName;
 
 	const FString FileString = ReadFileAsString(FileName);
@@ -508,3 +677,14 @@ bool FImportUtils::VerifyOrCreateDirectory(const FString& TestDir)
 	}
 	return true;
 }
+
+FImportStats& FImportUtils::GetImportStats()
+{
+	static FImportStats ImportStats;
+	return ImportStats;
+}
+
+void FImportUtils::ResetImportStats()
+{
+	GetImportStats() = FImportStats();
+}
@@ -0,0 +1,112 @@
+#include "Util/PlaybackBenchmark.h"
+
+#include "JsonObjectConverter.h"
+#include "RHI.h"
+#include "Misc/FileHelper.h"
+
+
+DEFINE_LOG_CATEGORY(LogPlaybackBenchmark);
+
+
+FPlaybackBenchmarkSettings FPlaybackBenchmarkSettings::FromCommandLine(const TCHAR* Params)
+{
+	FPlaybackBenchmarkSettings Settings;
+	FParse::Value(Params, TEXT("UpdateRate="), Settings.UpdateRate);
+	FParse::Value(Params, TEXT("SeekBursts="), Settings.NumSeekBursts);
+	FParse::Value(Params, TEXT("SeekSteps="), Settings.SeekBurstSteps);
+	FParse::Value(Params, TEXT("Report="), Settings.ReportFile);
+
+	FString ActorNames;
+	if (FParse::Value(Params, TEXT("Actors="), ActorNames, false))
+		ActorNames.ParseIntoArray(Settings.ActorNames, TEXT(","));
+
+	Settings.bObstructions = !FParse::Param(Params, TEXT("NoObsts"));
+	Settings.bSlices = !FParse::Param(Params, TEXT("NoSlices"));
+	Settings.bVolumes = !FParse::Param(Params, TEXT("NoVolumes"));
+	Settings.bQuitWhenFinished = FParse::Param(Params, TEXT("Quit"));
+	return Settings;
+}
+
+/** Returns the mean, the 95th percentile and the maximum of the given samples */
+static void GetSampleStats(TArray<float> Samples, float& OutMean, float& OutP95, float& OutMax)
+{
+	OutMean = OutP95 = OutMax = 0;
+	if (Samples.Num() == 0) return;
+
+	Samples.Sort();
+	double Sum = 0;
+	for (const float Sample : Samples) Sum += Sample;
+	OutMean = Sum / Samples.Num();
+	OutP95 = Samples[FMath::Min(Samples.Num() - 1, FMath::FloorToInt(Samples.Num() * .95f))];
+	OutMax = Samples.Last();
+}
+
+FPlaybackBenchmark::FPlaybackBenchmark(const FPlaybackBenchmarkSettings& InSettings) : Settings(InSettings),
+	StartTime(FPlatformTime::Seconds())
+{
+}
+
+void FPlaybackBenchmark::AddTimeStep(const bool bStalled)
+{
+	++Counters.NumTimeSteps;
+	if (bStalled) ++Counters.NumStalledTimeSteps;
+}
+
+void FPlaybackBenchmark::AddTextureRequest(const int NumTextures, const int NumHits)
+{
+	Counters.NumTextureRequests += NumTextures;
+	NumTextureHits += NumHits;
+}
+
+void FPlaybackBenchmark::AddStreamLatency(const double Seconds)
+{
+	StreamLatencies.Add(Seconds * 1000);
+}
+
+void FPlaybackBenchmark::AddNextTimeStepTime(const double Seconds)
+{
+	NextTimeStepTimes.Add(Seconds * 1000);
+}
+
+void FPlaybackBenchmark::AddLoadUnloadTimeStepTime(const double Seconds)
+{
+	LoadUnloadTimeStepTimes.Add(Seconds * 1000);
+}
+
+void FPlaybackBenchmark::SampleTextureMemory()
+{
+	FTextureMemoryStats TextureMemoryStats;
+	RHIGetTextureMemoryStats(TextureMemoryStats);
+	Counters.PeakTextureMemory = FMath::Max(Counters.PeakTextureMemory,
+	                                        TextureMemoryStats.StreamingMemorySize +
+	                                        TextureMemoryStats.NonStreamingMemorySize);
+}
+
+FPlaybackBenchmarkResults FPlaybackBenchmark::GetResults() const
+{
+	FPlaybackBenchmarkResults Results = Counters;
+	Results.CacheHitRate = Counters.NumTextureRequests > 0
+		                       ? static_cast<float>(NumTextureHits) / Counters.NumTextureRequests
+		                       : 1.f;
+	GetSampleStats(StreamLatencies, Results.MeanStreamLatency, Results.P95StreamLatency, Results.MaxStreamLatency);
+	float P95;
+	GetSampleStats(NextTimeStepTimes, Results.MeanNextTimeStepTime, P95, Results.MaxNextTimeStepTime);
+	GetSampleStats(LoadUnloadTimeStepTimes, Results.MeanLoadUnloadTimeStepTime, P95,
+	               Results.MaxLoadUnloadTimeStepTime);
+	Results.TotalSeconds = FPlatformTime::Seconds() - StartTime;
+	return Results;
+}
+
+bool FPlaybackBenchmark::WriteReport(const FPlaybackBenchmarkResults& Results) const
+{
+	const FString ReportFile = Settings.ReportFile.IsEmpty()
+		                           ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PlaybackBenchmark"),
+		                                             TEXT("PlaybackBenchmark.json"))
+		                           : Settings.ReportFile;
+	FString Json;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(Results, Json)) return false;
+	if (!FFileHelper::SaveStringToFile(Json, *ReportFile)) return false;
+
+	UE_LOG(LogPlaybackBenchmark, Log, TEXT("Wrote the results of the playback benchmark to %s"), *ReportFile);
+	return true;
+}
@@ -0,0 +1,22 @@
+#include "Util/PlaybackWindow.h"
+
+
+bool FPlaybackWindow::AdvanceTimeStep(const FString& Type, TMap<FString, int>& TimeSteps,
+                                      const TMap<FString, int>& NumTimeSteps,
+                                      TFunctionRef<void(const FString& SkippedType, int SkippedTimeStep)> SkipTimeStep)
+{
+	if (++TimeSteps[Type] < NumTimeSteps[Type]) return false;
+
+	for (TPair<FString, int>& TimeStep : TimeSteps)
+	{
+		if (TimeStep.Key == Type)
+		{
+			TimeStep.Value = 0;
+			continue;
+		}
+		// Step through all timesteps that will be skipped by setting time back to 0
+		for (int t = TimeStep.Value; t < NumTimeSteps[TimeStep.Key]; ++t) SkipTimeStep(TimeStep.Key, t);
+		TimeStep.Value = -1;
+	}
+	return true;
+}
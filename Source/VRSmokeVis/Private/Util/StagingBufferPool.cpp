@@ -0,0 +1,124 @@
+#include "Util/StagingBufferPool.h"
+
+
+DEFINE_LOG_CATEGORY(LogStagingBufferPool);
+
+
+FStagingBufferPool& FStagingBufferPool::Get()
+{
+	static FStagingBufferPool Pool;
+	return Pool;
+}
+
+FStagingBufferPool::~FStagingBufferPool()
+{
+	Trim();
+}
+
+uint8* FStagingBufferPool::Acquire(const int64 Size)
+{
+	const int64 BucketSize = GetBucketSize(Size);
+	FScopeLock Lock(&CriticalSection);
+
+	uint8* Buffer;
+	TArray<uint8*>* Bucket = FreeBuffers.Find(BucketSize);
+	if (Bucket && Bucket->Num() > 0)
+	{
+		Buffer = Bucket->Pop(false);
+		Stats.PooledBytes -= BucketSize;
+		++Stats.NumHits;
+	}
+	else
+	{
+		Buffer = static_cast<uint8*>(FMemory::Malloc(BucketSize, Alignment));
+		++Stats.NumMisses;
+	}
+	UsedBuffers.Add(Buffer, BucketSize);
+	Stats.UsedBytes += BucketSize;
+	return Buffer;
+}
+
+void FStagingBufferPool::Release(uint8* Buffer)
+{
+	if (!Buffer) return;
+
+	FScopeLock Lock(&CriticalSection);
+	int64 BucketSize;
+	if (!UsedBuffers.RemoveAndCopyValue(Buffer, BucketSize))
+	{
+		UE_LOG(LogStagingBufferPool, Error, TEXT("Tried to release a buffer that has not been acquired from the pool"));
+		return;
+	}
+	Stats.UsedBytes -= BucketSize;
+
+	TArray<uint8*>& Bucket = FreeBuffers.FindOrAdd(BucketSize);
+	if (BucketSize > MaxPooledBufferSize || Bucket.Num() >= MaxPooledBuffersPerBucket ||
+		Stats.PooledBytes + BucketSize > MaxPooledBytes)
+	{
+		FMemory::Free(Buffer);
+		return;
+	}
+	Bucket.Add(Buffer);
+	Stats.PooledBytes += BucketSize;
+}
+
+void FStagingBufferPool::Trim()
+{
+	FScopeLock Lock(&CriticalSection);
+	for (TPair<int64, TArray<uint8*>>& Bucket : FreeBuffers)
+	{
+		for (uint8* Buffer : Bucket.Value) FMemory::Free(Buffer);
+	}
+	FreeBuffers.Empty();
+	Stats.PooledBytes = 0;
+}
+
+FStagingBufferPoolStats FStagingBufferPool::GetStats() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Stats;
+}
+
+int64 FStagingBufferPool::GetBucketSize(const int64 Size)
+{
+	// Buffers that are not pooled anyway shouldn't waste up to half of their memory
+	if (Size > MaxPooledBufferSize) return Align(Size, Alignment);
+	if (Size > MaxPowerOfTwoBucketSize)
+		return Align(Size, (1ll << FMath::FloorLog2_64(Size)) / SizeClassesPerPowerOfTwo);
+	return FMath::Max(MinBucketSize, static_cast<int64>(FMath::RoundUpToPowerOfTwo64(Size)));
+}
+
+FStagingBuffer::FStagingBuffer(const int64 InSize) : Data(FStagingBufferPool::Get().Acquire(InSize)), Size(InSize)
+{
+}
+
+FStagingBuffer::~FStagingBuffer()
+{
+	Reset();
+}
+
+FStagingBuffer::FStagingBuffer(FStagingBuffer&& Other) noexcept : Data(Other.Data), Size(Other.Size)
+{
+	Other.Data = nullptr;
+	Other.Size = 0;
+}
+
+FStagingBuffer& FStagingBuffer::operator=(FStagingBuffer&& Other) noexcept
+{
+	if (this != &Other)
+	{
+		Reset();
+		Data = Other.Data;
+		Size = Other.Size;
+		Other.Data = nullptr;
+		Other.Size = 0;
+	}
+	return *this;
+}
+
+void FStagingBuffer::Reset()
+{
+	FStagingBufferPool::Get().Release(Data);
+	Data = nullptr;
+	Size = 0;
+}
@@ -0,0 +1,354 @@
+#include "Util/SyntheticDataGenerator.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "Util/StagingBufferPool.h"
+
+
+DEFINE_LOG_CATEGORY(LogSyntheticData);
+
+
+/** Size of a single cell in meters */
+static constexpr float CellSize = .1f;
+
+/** Simulated time between two timesteps in seconds */
+static constexpr float TimeStepDuration = .1f;
+
+/** Range of the temperatures written for slices and obstructions */
+static constexpr float MinTemperature = 20.f;
+static constexpr float MaxTemperature = 620.f;
+
+static uint8 Quantize(const float Value)
+{
+	return FMath::Clamp(Value, 0.f, 1.f) * 255.f + .5f;
+}
+
+/** Hashes the given values to a number between 0 and 1, the same values always result in the same number */
+static float Hash01(const uint32 A, const uint32 B, const uint32 C)
+{
+	uint32 Hash = HashCombine(HashCombine(A, B), C);
+	// Finalizer of MurmurHash3, distributes the bits of the simple combination above
+	Hash ^= Hash >> 16;
+	Hash *= 0x85ebca6b;
+	Hash ^= Hash >> 13;
+	Hash *= 0xc2b2ae35;
+	Hash ^= Hash >> 16;
+	return static_cast<float>(Hash) / MAX_uint32;
+}
+
+/** Returns the time of a timestep normalized to the duration of the simulation */
+static float GetNormalizedTime(const FSyntheticDataSettings& Settings, const int TimeStep)
+{
+	return Settings.NumTimeSteps > 1 ? static_cast<float>(TimeStep) / (Settings.NumTimeSteps - 1) : 0.f;
+}
+
+/** Returns the two axes spanning a face of an obstruction with the given orientation, e.g. y and z for -1 and 1 */
+static FIntPoint GetFaceAxes(const int Orientation)
+{
+	const int Axis = FMath::Abs(Orientation) - 1;
+	return FIntPoint(Axis == 0 ? 1 : 0, Axis == 2 ? 1 : 2);
+}
+
+FSyntheticDataSettings FSyntheticDataSettings::FromCommandLine(const TCHAR* Params)
+{
+	FSyntheticDataSettings Settings;
+	FParse::Value(Params, TEXT("Meshes="), Settings.NumMeshes);
+	FParse::Value(Params, TEXT("TimeSteps="), Settings.NumTimeSteps);
+	FParse::Value(Params, TEXT("Obstructions="), Settings.NumObstructions);
+	FParse::Value(Params, TEXT("Slices="), Settings.NumSlices);
+	FParse::Value(Params, TEXT("Volumes="), Settings.NumVolumes);
+	FParse::Value(Params, TEXT("Seed="), Settings.Seed);
+
+	int Scale = 1;
+	if (FParse::Value(Params, TEXT("Scale="), Scale)) Settings.NumMeshes *= FMath::Max(1, Scale);
+
+	FString Resolution;
+	if (FParse::Value(Params, TEXT("Resolution="), Resolution))
+	{
+		TArray<FString> Cells;
+		Resolution.ParseIntoArray(Cells, TEXT("x"));
+		if (Cells.Num() == 3)
+		{
+			Settings.MeshResolution = FIntVector(FCString::Atoi(*Cells[0]), FCString::Atoi(*Cells[1]),
+			                                     FCString::Atoi(*Cells[2]));
+		}
+		else
+		{
+			UE_LOG(LogSyntheticData, Warning, TEXT("Ignoring resolution %s, expected XxYxZ"), *Resolution);
+		}
+	}
+
+	FString Pattern;
+	if (FParse::Value(Params, TEXT("Pattern="), Pattern))
+	{
+		if (Pattern.Equals(TEXT("Layers"), ESearchCase::IgnoreCase))
+			Settings.Pattern = ESyntheticDataPattern::Layers;
+		else if (Pattern.Equals(TEXT("Noise"), ESearchCase::IgnoreCase))
+			Settings.Pattern = ESyntheticDataPattern::Noise;
+		else
+			Settings.Pattern = ESyntheticDataPattern::Plume;
+	}
+
+	Settings.NumMeshes = FMath::Max(1, Settings.NumMeshes);
+	Settings.NumTimeSteps = FMath::Max(1, Settings.NumTimeSteps);
+	Settings.MeshResolution = FIntVector(FMath::Max(2, Settings.MeshResolution.X),
+	                                     FMath::Max(2, Settings.MeshResolution.Y),
+	                                     FMath::Max(2, Settings.MeshResolution.Z));
+	return Settings;
+}
+
+FString FSyntheticDataSettings::ToString() const
+{
+	const TCHAR* PatternNames[] = {TEXT("Plume"), TEXT("Layers"), TEXT("Noise")};
+	return FString::Printf(
+		TEXT("Meshes=%d Resolution=%dx%dx%d TimeSteps=%d Obstructions=%d Slices=%d Volumes=%d Pattern=%s Seed=%d"),
+		NumMeshes, MeshResolution.X, MeshResolution.Y, MeshResolution.Z, NumTimeSteps, NumObstructions, NumSlices,
+		NumVolumes, PatternNames[static_cast<uint8>(Pattern)], Seed);
+}
+
+FString FSyntheticDataGenerator::GenerateSimulation(const FSyntheticDataSettings& Settings, const FString& OutputDir)
+{
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*OutputDir);
+	UE_LOG(LogSyntheticData, Log, TEXT("Generating synthetic simulation in %s: %s"), *OutputDir, *Settings.ToString());
+
+	TArray<FString> ObstFiles, SliceFiles, VolumeFiles;
+	for (int i = 0; i < Settings.NumObstructions; ++i) ObstFiles.Add(WriteObstruction(Settings, OutputDir, i));
+	for (int i = 0; i < Settings.NumSlices; ++i) SliceFiles.Add(WriteSlice(Settings, OutputDir, i));
+	for (int i = 0; i < Settings.NumVolumes; ++i) VolumeFiles.Add(WriteVolume(Settings, OutputDir, i));
+	if (ObstFiles.Contains("") || SliceFiles.Contains("") || VolumeFiles.Contains("")) return "";
+
+	// The same settings always result in the same data and therefore in the same hash
+	FString Yaml = "Hash: " + FMD5::HashAnsiString(*Settings.ToString()) + "\n";
+	Yaml += FString::Printf(TEXT("NumObstructions: %d\nNumSlices: %d\nNumVolumes: %d\n"), ObstFiles.Num(),
+	                        SliceFiles.Num(), VolumeFiles.Num());
+	Yaml += "Obstructions:\n";
+	for (const FString& File : ObstFiles) Yaml += "- " + File + "\n";
+	Yaml += "Slices:\n";
+	for (const FString& File : SliceFiles) Yaml += "- " + File + "\n";
+	Yaml += "Volumes:\n";
+	for (const FString& File : VolumeFiles) Yaml += "- " + File + "\n";
+
+	const FString SimulationFile = FPaths::Combine(OutputDir, TEXT("Synthetic-smv.yaml"));
+	if (!FFileHelper::SaveStringToFile(Yaml, *SimulationFile)) return "";
+	return SimulationFile;
+}
+
+FString FSyntheticDataGenerator::WriteObstruction(const FSyntheticDataSettings& Settings, const FString& OutputDir,
+                                                  const int Index)
+{
+	const FIntVector& Resolution = Settings.MeshResolution;
+	const FIntVector DomainCells(Resolution.X * Settings.NumMeshes, Resolution.Y, Resolution.Z);
+
+	// Boxes of different sizes standing on the floor, scattered over the whole domain
+	FIntVector BoxCells;
+	BoxCells.X = FMath::Max(1, FMath::RoundToInt(DomainCells.X * (.02f + .08f * Hash01(Settings.Seed, Index, 0))));
+	BoxCells.Y = FMath::Max(1, FMath::RoundToInt(DomainCells.Y * (.05f + .15f * Hash01(Settings.Seed, Index, 1))));
+	BoxCells.Z = FMath::Max(1, FMath::RoundToInt(DomainCells.Z * (.1f + .4f * Hash01(Settings.Seed, Index, 2))));
+	const FVector BoxMin((DomainCells.X - BoxCells.X) * Hash01(Settings.Seed, Index, 3),
+	                     (DomainCells.Y - BoxCells.Y) * Hash01(Settings.Seed, Index, 4), 0);
+	const FVector BoxMax = BoxMin + FVector(BoxCells);
+
+	const FString Name = "obst-" + FString::FromInt(Index + 1);
+	const FString DataFileName = Name + "_wall_temperature.dat";
+
+	FString Yaml = FString::Printf(TEXT("BoundingBox: %f %f %f %f %f %f\n"), BoxMin.X * CellSize,
+	                               BoxMax.X * CellSize, BoxMin.Y * CellSize, BoxMax.Y * CellSize,
+	                               BoxMin.Z * CellSize, BoxMax.Z * CellSize);
+	Yaml += "NumOrientations: 6\nNumQuantities: 1\nOrientations:\n";
+
+	// The faces are written one after another in the order of the orientations, each with all of its timesteps
+	const int Orientations[] = {-1, 1, -2, 2, -3, 3};
+	TArray<FIntPoint> FaceCells;
+	for (const int Orientation : Orientations)
+	{
+		const FIntPoint Axes = GetFaceAxes(Orientation);
+		FaceCells.Emplace(BoxCells[Axes.X], BoxCells[Axes.Y]);
+		Yaml += FString::Printf(TEXT("- BoundaryOrientation: %d\n  DimSize: %d %d\n  Spacing: %f %f %f\n"), Orientation,
+		                        FaceCells.Last().X, FaceCells.Last().Y, TimeStepDuration, CellSize, CellSize);
+	}
+	Yaml += FString::Printf(TEXT("Quantities:\n- BoundaryQuantity: WALL TEMPERATURE\n  DataFile: %s\n"
+		                        "  DataValMax: %f\n  DataValMin: %f\n  ScaleFactor: %f\n"), *DataFileName,
+	                        MaxTemperature, MinTemperature, 255.f / (MaxTemperature - MinTemperature));
+	Yaml += FString::Printf(TEXT("TimeSteps: %d\n"), Settings.NumTimeSteps);
+
+	// Unlike slices and volumes, boundary data is stored face by face and not timestep by timestep
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*FPaths::Combine(OutputDir, DataFileName)));
+	if (!FileHandle)
+	{
+		UE_LOG(LogSyntheticData, Error, TEXT("Could not write data file %s"), *DataFileName);
+		return "";
+	}
+	for (int f = 0; f < UE_ARRAY_COUNT(Orientations); ++f)
+	{
+		const int Axis = FMath::Abs(Orientations[f]) - 1;
+		const FIntPoint Axes = GetFaceAxes(Orientations[f]);
+		const int64 TimeStepSize = static_cast<int64>(FaceCells[f].X) * FaceCells[f].Y;
+		const FStagingBuffer Buffer(TimeStepSize);
+		for (int t = 0; t < Settings.NumTimeSteps; ++t)
+		{
+			const float Time = GetNormalizedTime(Settings, t);
+			for (int v = 0; v < FaceCells[f].Y; ++v)
+			{
+				for (int u = 0; u < FaceCells[f].X; ++u)
+				{
+					FVector Position;
+					Position[Axis] = Orientations[f] < 0 ? BoxMin[Axis] : BoxMax[Axis];
+					Position[Axes.X] = BoxMin[Axes.X] + u + .5f;
+					Position[Axes.Y] = BoxMin[Axes.Y] + v + .5f;
+					Buffer.GetData()[static_cast<int64>(v) * FaceCells[f].X + u] = Quantize(
+						SampleField(Settings, Position / FVector(DomainCells), Time));
+				}
+			}
+			if (!FileHandle->Write(Buffer.GetData(), TimeStepSize))
+			{
+				UE_LOG(LogSyntheticData, Error, TEXT("Could not write data file %s"), *DataFileName);
+				return "";
+			}
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(Yaml, *FPaths::Combine(OutputDir, Name + ".yaml"))) return "";
+	return Name + ".yaml";
+}
+
+FString FSyntheticDataGenerator::WriteSlice(const FSyntheticDataSettings& Settings, const FString& OutputDir,
+                                            const int Index)
+{
+	const FIntVector& Resolution = Settings.MeshResolution;
+	// Slices are evenly distributed over the height of the domain
+	const float Height = static_cast<float>(Index + 1) / (Settings.NumSlices + 1);
+	const FString Name = "slice-" + FString::FromInt(Index + 1);
+
+	FString Yaml = FString::Printf(TEXT("CellCentered: 0\nDataValMax: %f\nDataValMin: %f\nMeshNum: %d\nMeshes:\n"),
+	                               MaxTemperature, MinTemperature, Settings.NumMeshes);
+	for (int m = 0; m < Settings.NumMeshes; ++m)
+	{
+		const FString DataFileName = FString::Printf(TEXT("%s_mesh-%d.dat"), *Name, m + 1);
+		Yaml += FString::Printf(TEXT("- Mesh: %d\n  MeshPos: %f %f %f\n  DimSize: %d %d %d 1\n  Spacing: %f %f %f %f\n"
+			                        "  DataFile: %s\n"), m + 1, m * Resolution.X * CellSize, 0.f,
+		                        Height * Resolution.Z * CellSize, Settings.NumTimeSteps, Resolution.X, Resolution.Y,
+		                        TimeStepDuration, CellSize, CellSize, CellSize, *DataFileName);
+
+		const auto FillTimeStep = [&](const int TimeStep, uint8* Data)
+		{
+			const float Time = GetNormalizedTime(Settings, TimeStep);
+			for (int y = 0; y < Resolution.Y; ++y)
+			{
+				for (int x = 0; x < Resolution.X; ++x)
+				{
+					const FVector Position((m * Resolution.X + x + .5f) / (Resolution.X * Settings.NumMeshes),
+					                       (y + .5f) / Resolution.Y, Height);
+					Data[static_cast<int64>(y) * Resolution.X + x] = Quantize(SampleField(Settings, Position, Time));
+				}
+			}
+		};
+		const bool bSuccess = WriteDataFile(FPaths::Combine(OutputDir, DataFileName),
+		                                    static_cast<int64>(Resolution.X) * Resolution.Y, Settings.NumTimeSteps,
+		                                    FillTimeStep);
+		if (!bSuccess) return "";
+	}
+	Yaml += FString::Printf(TEXT("Quantity: TEMPERATURE\nScaleFactor: %f\n"),
+	                        255.f / (MaxTemperature - MinTemperature));
+
+	if (!FFileHelper::SaveStringToFile(Yaml, *FPaths::Combine(OutputDir, Name + ".yaml"))) return "";
+	return Name + ".yaml";
+}
+
+FString FSyntheticDataGenerator::WriteVolume(const FSyntheticDataSettings& Settings, const FString& OutputDir,
+                                             const int Index)
+{
+	const FIntVector& Resolution = Settings.MeshResolution;
+	const FString Name = "smoke-" + FString::FromInt(Index + 1);
+
+	FString Yaml = FString::Printf(TEXT("DataValMax: 1.000000\nDataValMin: 0.000000\nMeshNum: %d\nMeshes:\n"),
+	                               Settings.NumMeshes);
+	for (int m = 0; m < Settings.NumMeshes; ++m)
+	{
+		const FString DataFileName = FString::Printf(TEXT("%s_mesh-%d.dat"), *Name, m + 1);
+		Yaml += FString::Printf(TEXT("- Mesh: %d\n  MeshPos: %f %f %f\n  DimSize: %d %d %d %d\n"
+			                        "  Spacing: %f %f %f %f\n  DataFile: %s\n"), m + 1, m * Resolution.X * CellSize,
+		                        0.f, 0.f, Settings.NumTimeSteps, Resolution.X, Resolution.Y, Resolution.Z,
+		                        TimeStepDuration, CellSize, CellSize, CellSize, *DataFileName);
+
+		const int64 TimeStepSize = static_cast<int64>(Resolution.X) * Resolution.Y * Resolution.Z;
+		const auto FillTimeStep = [&](const int TimeStep, uint8* Data)
+		{
+			const float Time = GetNormalizedTime(Settings, TimeStep);
+			// The x-axis is the fastest running one, then y and z
+			ParallelFor(Resolution.Z, [&](const int z)
+			{
+				for (int y = 0; y < Resolution.Y; ++y)
+				{
+					uint8* Row = Data + (static_cast<int64>(z) * Resolution.Y + y) * Resolution.X;
+					for (int x = 0; x < Resolution.X; ++x)
+					{
+						const FVector Position((m * Resolution.X + x + .5f) / (Resolution.X * Settings.NumMeshes),
+						                       (y + .5f) / Resolution.Y, (z + .5f) / Resolution.Z);
+						Row[x] = Quantize(SampleField(Settings, Position, Time));
+					}
+				}
+			});
+		};
+		const bool bSuccess = WriteDataFile(FPaths::Combine(OutputDir, DataFileName), TimeStepSize,
+		                                    Settings.NumTimeSteps, FillTimeStep);
+		if (!bSuccess) return "";
+	}
+	Yaml += "Quantity: SOOT DENSITY\nScaleFactor: 255.000000\n";
+
+	if (!FFileHelper::SaveStringToFile(Yaml, *FPaths::Combine(OutputDir, Name + ".yaml"))) return "";
+	return Name + ".yaml";
+}
+
+bool FSyntheticDataGenerator::WriteDataFile(const FString& FilePath, const int64 TimeStepSize, const int NumTimeSteps,
+                                            TFunctionRef<void(int TimeStep, uint8* Data)> FillTimeStep)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*FilePath));
+	if (!FileHandle)
+	{
+		UE_LOG(LogSyntheticData, Error, TEXT("Could not open data file %s for writing"), *FilePath);
+		return false;
+	}
+
+	// A single timestep is generated at a time, so even huge simulations only need little memory
+	const FStagingBuffer Buffer(TimeStepSize);
+	for (int t = 0; t < NumTimeSteps; ++t)
+	{
+		FillTimeStep(t, Buffer.GetData());
+		if (!FileHandle->Write(Buffer.GetData(), TimeStepSize))
+		{
+			UE_LOG(LogSyntheticData, Error, TEXT("Could not write timestep %d to data file %s"), t, *FilePath);
+			return false;
+		}
+	}
+	return true;
+}
+
+float FSyntheticDataGenerator::SampleField(const FSyntheticDataSettings& Settings, const FVector& Position,
+                                           const float Time)
+{
+	switch (Settings.Pattern)
+	{
+	case ESyntheticDataPattern::Layers:
+	{
+		// The layer starts at the ceiling and fills most of the domain at the end of the simulation
+		const float Interface = 1.f - .7f * Time;
+		return Position.Z < Interface ? 0.f : FMath::Min(1.f, .2f + (Position.Z - Interface) * 4.f);
+	}
+	case ESyntheticDataPattern::Noise:
+		return Hash01(Settings.Seed, GetTypeHash(Position), GetTypeHash(Time));
+	default:
+	{
+		// The plume widens with increasing height and its front reaches the ceiling after two thirds of the time
+		if (Position.Z > Time * 1.5f) return 0.f;
+		const float Radius = .05f + .15f * Position.Z;
+		const float Distance = FVector2D(Position.X - .5f, Position.Y - .5f).Size();
+		const float Value = FMath::Exp(-FMath::Square(Distance / Radius));
+		// Cut off the tail of the gaussian, otherwise no cell would ever be empty
+		return Value < .02f ? 0.f : Value;
+	}
+	}
+}
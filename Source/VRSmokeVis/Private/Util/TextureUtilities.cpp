@@ -1,6 +1,11 @@
 #include "Util/TextureUtilities.h"
 
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "Util/ImportUtilities.h"
+#include "VRSSStats.h"
 
 
 DEFINE_LOG_CATEGORY(LogTextureUtils);
@@ -26,7 +31,7 @@ void FTextureUtils::SetTextureDetails(UTexture* OutTexture, const FVector4 Dimen
 }
 
 void FTextureUtils::CreateTextureMip(UTexture* OutTexture, const FVector4 Dimensions,
-                                     uint8* BulkData, const int DataSize)
+                                     uint8* BulkData, const int64 DataSize)
 {
 	// Create the one and only mip in this texture.
 	FTexture2DMipMap* Mip = new FTexture2DMipMap();
@@ -71,8 +76,10 @@ bool FTextureUtils::CreateTextureEditorData(UTexture* Texture, const FVector4 Di
 #endif
 
 UTexture2D* FTextureUtils::CreateTextureAsset(const FString AssetName, const FVector4 Dimensions, UObject* OutPackage,
-                                              uint8* BulkData, const int DataSize)
+                                              uint8* BulkData, const int64 DataSize)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_CreateTexture);
+	FScopedDurationTimer CreateTimer(FImportUtils::GetImportStats().TextureCreateSeconds);
 	UTexture2D* Texture = NewObject<UTexture2D>(OutPackage, FName(*AssetName),
 	                                            RF_Public | RF_Standalone | RF_MarkAsRootSet);
 
@@ -96,36 +103,53 @@ UTexture2D* FTextureUtils::CreateTextureAsset(const FString AssetName, const FVe
 	return Texture;
 }
 
-UTexture2D* FTextureUtils::CreateSliceTextureAsset(const FString AssetName, FVector4 Dimensions, UObject* OutPackage,
-                                                   uint8* BulkData, const int DataSize)
+UTexture2D* FTextureUtils::CreateSliceTextureAsset(const FString AssetName, const FVector4 Dimensions, UObject* OutPackage,
+                                                   uint8* BulkData, const int64 DataSize)
 {
-	// The following function call expects the first two dimensions to be the ones describing the texture
-	// dimensions, we therefore might have to swap them now
-	const bool SwapX = Dimensions.X == 1;
-	const bool SwapY = Dimensions.Y == 1;
-	if (SwapX)
-	{
-		const float Tmp = Dimensions.X;
-		Dimensions.X = Dimensions.Y;
-		Dimensions.Y = Dimensions.Z;
-		Dimensions.Z = Tmp;
-	}
-	if (SwapY)
-	{
-		const float Tmp = Dimensions.Y;
-		Dimensions.Y = Dimensions.Z;
-		Dimensions.Z = Tmp;
-	}
-
-	UTexture2D* SliceTexture = CreateTextureAsset(AssetName, Dimensions, OutPackage, BulkData, DataSize);
+	UTexture2D* SliceTexture = CreateTextureAsset(AssetName, GetSliceTextureDimensions(Dimensions), OutPackage, BulkData,
+	                                              DataSize);
 
 	return SliceTexture;
 }
 
+UTexture2DArray* FTextureUtils::CreateSliceTextureArrayAsset(const FString AssetName, const FVector4 Dimensions,
+                                                             UObject* OutPackage, uint8* BulkData,
+                                                             const int64 DataSize)
+{
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_CreateTexture);
+	FScopedDurationTimer CreateTimer(FImportUtils::GetImportStats().TextureCreateSeconds);
+	UTexture2DArray* Texture = NewObject<UTexture2DArray>(OutPackage, FName(*AssetName),
+	                                                      RF_Public | RF_Standalone | RF_MarkAsRootSet);
+
+	// Prevent garbage collection of the texture
+	Texture->AddToRoot();
+
+	// The layers of the array are stored like the slices of a volume texture
+	FVector4 TextureDimensions = GetSliceTextureDimensions(Dimensions);
+	TextureDimensions.Z = Dimensions.W;
+
+	SetTextureDetails(Texture, TextureDimensions);
+	CreateTextureMip(Texture, TextureDimensions, BulkData, DataSize);
+#if WITH_EDITOR
+	CreateTextureEditorData(Texture, TextureDimensions, BulkData);
+#endif
+	Texture->Filter = TF_Default;
+
+	// Update resource, mark that the folder needs to be rescanned and notify editor about asset creation.
+	Texture->UpdateResource();
+
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	AssetRegistryModule.Get().AssetCreated(Texture);
+
+	return Texture;
+}
+
 UVolumeTexture* FTextureUtils::CreateVolumeAsset(const FString AssetName, const FVector4 Dimensions,
                                                  UObject* OutPackage,
-                                                 uint8* BulkData, const int DataSize)
+                                                 uint8* BulkData, const int64 DataSize)
 {
+	VRSS_SCOPE_CYCLE_COUNTER(STAT_VRSS_CreateTexture);
+	FScopedDurationTimer CreateTimer(FImportUtils::GetImportStats().TextureCreateSeconds);
 	UVolumeTexture* Texture = NewObject<UVolumeTexture>(OutPackage, FName(*AssetName),
 	                                                    RF_Public | RF_Standalone | RF_MarkAsRootSet);
 
@@ -147,3 +171,107 @@ UVolumeTexture* FTextureUtils::CreateVolumeAsset(const FString AssetName, const
 
 	return Texture;
 }
+
+FIntPoint FTextureUtils::PackAtlas(const TArray<FIntPoint>& Sizes, TArray<FIntPoint>& OutOffsets)
+{
+	OutOffsets.SetNumZeroed(Sizes.Num());
+	if (Sizes.Num() == 0) return FIntPoint::ZeroValue;
+
+	// Aim for a roughly square atlas, but make sure that even the widest rectangle fits into a single row
+	int64 TotalArea = 0;
+	int MaxWidth = 0;
+	for (const FIntPoint& Size : Sizes)
+	{
+		TotalArea += static_cast<int64>(Size.X) * Size.Y;
+		MaxWidth = FMath::Max(MaxWidth, Size.X);
+	}
+	const int AtlasWidth = FMath::Max(MaxWidth, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(TotalArea))));
+
+	// Placing the highest rectangles first wastes the least amount of space in each row
+	TArray<int> Order;
+	Order.Reserve(Sizes.Num());
+	for (int i = 0; i < Sizes.Num(); ++i) Order.Add(i);
+	Order.StableSort([&Sizes](const int Lhs, const int Rhs) { return Sizes[Lhs].Y > Sizes[Rhs].Y; });
+
+	FIntPoint Cursor = FIntPoint::ZeroValue;
+	int RowHeight = 0;
+	for (const int i : Order)
+	{
+		if (Cursor.X + Sizes[i].X > AtlasWidth)
+		{
+			Cursor = FIntPoint(0, Cursor.Y + RowHeight);
+			RowHeight = 0;
+		}
+		OutOffsets[i] = Cursor;
+		Cursor.X += Sizes[i].X;
+		RowHeight = FMath::Max(RowHeight, Sizes[i].Y);
+	}
+	return FIntPoint(AtlasWidth, Cursor.Y + RowHeight);
+}
+
+UTexture* FTextureUtils::CreateTransientTexture(const FIntVector Dimensions)
+{
+	UTexture* Texture;
+	if (Dimensions.Z > 1)
+		Texture = NewObject<UVolumeTexture>(GetTransientPackage(), NAME_None, RF_Transient);
+	else
+		Texture = NewObject<UTexture2D>(GetTransientPackage(), NAME_None, RF_Transient);
+
+	const FVector4 TextureDimensions(Dimensions.X, Dimensions.Y, Dimensions.Z, 1);
+	TArray<uint8> EmptyData;
+	EmptyData.SetNumZeroed(Dimensions.X * Dimensions.Y * Dimensions.Z);
+	SetTextureDetails(Texture, TextureDimensions);
+	CreateTextureMip(Texture, TextureDimensions, EmptyData.GetData(), EmptyData.Num());
+	Texture->Filter = Dimensions.Z > 1 ? TF_Bilinear : TF_Default;
+	Texture->UpdateResource();
+
+	return Texture;
+}
+
+void FTextureUtils::UpdateTextureData(UTexture* Texture, const FIntVector Dimensions, FStagingBuffer&& Data)
+{
+	FTextureResource* Resource = Texture->GetResource();
+	if (!Resource || Data.Num() != static_cast<int64>(Dimensions.X) * Dimensions.Y * Dimensions.Z)
+	{
+		UE_LOG(LogTextureUtils, Warning, TEXT("Could not update the data of texture %s"), *Texture->GetName());
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(UpdateTextureData)(
+		[Resource, Dimensions, Data = MoveTemp(Data)](FRHICommandListImmediate& RHICmdList)
+		{
+			if (Dimensions.Z > 1)
+			{
+				const FUpdateTextureRegion3D Region(0, 0, 0, 0, 0, 0, Dimensions.X, Dimensions.Y, Dimensions.Z);
+				RHIUpdateTexture3D(Resource->GetTexture3DRHI(), 0, Region, Dimensions.X, Dimensions.X * Dimensions.Y,
+				                   Data.GetData());
+			}
+			else
+			{
+				const FUpdateTextureRegion2D Region(0, 0, 0, 0, Dimensions.X, Dimensions.Y);
+				RHIUpdateTexture2D(Resource->GetTexture2DRHI(), 0, Region, Dimensions.X, Data.GetData());
+			}
+		});
+}
+
+FVector4 FTextureUtils::GetSliceTextureDimensions(FVector4 Dimensions)
+{
+	// The texture functions expect the first two dimensions to be the ones describing the texture dimensions, we
+	// therefore might have to swap them now
+	const bool SwapX = Dimensions.X == 1;
+	const bool SwapY = Dimensions.Y == 1;
+	if (SwapX)
+	{
+		const float Tmp = Dimensions.X;
+		Dimensions.X = Dimensions.Y;
+		Dimensions.Y = Dimensions.Z;
+		Dimensions.Z = Tmp;
+	}
+	if (SwapY)
+	{
+		const float Tmp = Dimensions.Y;
+		Dimensions.Y = Dimensions.Z;
+		Dimensions.Z = Tmp;
+	}
+	return Dimensions;
+}
@@ -5,24 +5,59 @@
 
 UTexture2D* UVRSSConfig::GetColorMap(const FString Quantity)
 {
-	TArray<FAssetData> ColorMapTextures;
+	const FString* ColorMapName = GetColorMapName(Quantity);
+	return ColorMapName ? GetColorMapByName(*ColorMapName) : nullptr;
+}
+
+UTexture2D* UVRSSConfig::GetColorMapByName(const FString& Name)
+{
+	if (UTexture2D** ColorMap = LoadedColorMaps.Find(Name)) return *ColorMap;
 
+	DiscoverColorMaps();
+	const FSoftObjectPath* ColorMapPath = ColorMapPaths.Find(Name);
+	if (!ColorMapPath) return nullptr;
+
+	UTexture2D* ColorMap = StreamableManager.LoadSynchronous<UTexture2D>(*ColorMapPath);
+	LoadedColorMaps.Add(Name, ColorMap);
+	return ColorMap;
+}
+
+TArray<FString> UVRSSConfig::GetColorMapNames()
+{
+	DiscoverColorMaps();
+	return ColorMapNames;
+}
+
+void UVRSSConfig::DiscoverColorMaps()
+{
+	if (bColorMapsDiscovered) return;
+	bColorMapsDiscovered = true;
+
+	// The library is not added to the root set, so it will be garbage collected
+	TArray<FAssetData> ColorMapTextures;
 	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(UTexture2D::StaticClass(), false, GIsEditor);
-	ObjectLibrary->AddToRoot();
 	ObjectLibrary->LoadAssetDataFromPath(GetColorMapsPath());
 	ObjectLibrary->GetAssetDataList(ColorMapTextures);
 
-	if (const FString* ColorMapName = ColorMaps.Find(Quantity))
+	// The colormap textures follow a fixed naming scheme, "CM_" followed by the name of the colormap
+	for (const FAssetData& ColorMapTexture : ColorMapTextures)
 	{
-		for (const FAssetData& ColorMap : ColorMapTextures)
-		{
-			if (ColorMap.AssetName.ToString().Equals("CM_" + *ColorMapName))
-			{
-				return StreamableManager.LoadSynchronous<UTexture2D>(ColorMap.ToSoftObjectPath());
-			}
-		}
+		FString Name = ColorMapTexture.AssetName.ToString();
+		if (!Name.RemoveFromStart("CM_")) continue;
+		ColorMapPaths.Add(Name, ColorMapTexture.ToSoftObjectPath());
+		ColorMapNames.Add(Name);
 	}
-	return StreamableManager.LoadSynchronous<UTexture2D>(ColorMapTextures[0].ToSoftObjectPath());
+	ColorMapNames.Sort();
+}
+
+const FString* UVRSSConfig::GetColorMapName(const FString& Quantity)
+{
+	DiscoverColorMaps();
+	if (const FString* ColorMapName = ColorMaps.Find(Quantity); ColorMapName && ColorMapPaths.Contains(*ColorMapName))
+		return ColorMapName;
+
+	// Otherwise fall back to any colormap
+	return ColorMapNames.Num() > 0 ? &ColorMapNames[0] : nullptr;
 }
 
 float UVRSSConfig::GetSliceCutOffValue(const FString Quantity) const
@@ -61,4 +96,24 @@ void UVRSSConfig::SetActiveObstQuantity(const FString& NewQuantity)
 	ActiveObstQuantity = NewQuantity;
 
 	this->SaveConfig();
+}
+
+bool UVRSSConfig::ShouldPackObstAtlas() const
+{
+	return bPackObstAtlas;
+}
+
+int UVRSSConfig::GetSliceTimeStepsPerTexture() const
+{
+	return FMath::Max(1, SliceTimeStepsPerTexture);
+}
+
+int UVRSSConfig::GetVolumeTimeStepsPerTexture() const
+{
+	return FMath::Max(1, VolumeTimeStepsPerTexture);
+}
+
+bool UVRSSConfig::ShouldWriteTimeSeries() const
+{
+	return bWriteTimeSeries;
 }
\ No newline at end of file
@@ -8,6 +8,20 @@
 #include "UI/VRSSHUD.h"
 
 
+DEFINE_LOG_CATEGORY_STATIC(LogVRSSMemory, Log, All);
+
+static FAutoConsoleCommandWithWorldAndArgs MemoryUsageCommand(
+	TEXT("VRSmokeVis.MemoryUsage"),
+	TEXT("Logs the CPU and GPU memory used by each simulation and type, add -Actors to also list each actor"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, const UWorld* World)
+	{
+		if (!World || !World->GetGameInstance()) return;
+		if (const UVRSSGameInstanceSubsystem* Subsystem = World->GetGameInstance()->GetSubsystem<
+			UVRSSGameInstanceSubsystem>())
+			Subsystem->LogMemoryUsage(Args.Contains(TEXT("-Actors")));
+	}));
+
+
 UVRSSGameInstanceSubsystem::UVRSSGameInstanceSubsystem()
 {
 	Simulations = TArray<ASimulation*>();
@@ -21,26 +35,21 @@ void UVRSSGameInstanceSubsystem::Initialize(FSubsystemCollectionBase& Collection
 
 void UVRSSGameInstanceSubsystem::RegisterSimulation(ASimulation* Simulation)
 {
-	TMap<FString, float> Mins = TMap<FString, float>(), Maxs = TMap<FString, float>(), TmpMins = TMap<FString, float>(),
-	                     TmpMaxs = TMap<FString, float>();
+	TMap<FString, float> Mins = TMap<FString, float>(), Maxs = TMap<FString, float>();
 	// Get maximum and minimum values per quantity (value range) for the new simulation
 	Simulation->GetMaxMins(Mins, Maxs);
-	// Merge with other simulation ranges
-	for (const ASimulation* Sim : Simulations)
+	// Merge with the ranges of the other simulations, which are already contained in the index
+	for (const TPair<FString, float>& Min : Mins)
 	{
-		Sim->GetMaxMins(TmpMins, TmpMaxs);
-		for (auto Min : TmpMins)
+		if (float* QuantityMin = QuantityMins.Find(Min.Key))
+		{
+			*QuantityMin = FMath::Min(Min.Value, *QuantityMin);
+			QuantityMaxs[Min.Key] = FMath::Max(Maxs[Min.Key], QuantityMaxs[Min.Key]);
+		}
+		else
 		{
-			if (!Mins.Contains(Min.Key))
-			{
-				Mins.Add(Min.Key, Min.Value);
-				Maxs.Add(Min.Key, TmpMaxs[Min.Key]);
-			}
-			else
-			{
-				Mins[Min.Key] = FMath::Min(Min.Value, Mins[Min.Key]);
-				Maxs[Min.Key] = FMath::Max(TmpMaxs[Min.Key], Maxs[Min.Key]);
-			}
+			QuantityMins.Add(Min.Key, Min.Value);
+			QuantityMaxs.Add(Min.Key, Maxs[Min.Key]);
 		}
 	}
 
@@ -51,12 +60,12 @@ void UVRSSGameInstanceSubsystem::RegisterSimulation(ASimulation* Simulation)
 	UVRSSGameInstanceSubsystem* GI = GetGameInstance()->GetSubsystem<UVRSSGameInstanceSubsystem>();
 	AVRSSHUD* HUD = Cast<AVRSSHUD>(GetWorld()->GetFirstPlayerController()->GetHUD());
 	HUD->InitHUD();
-	HUD->UserInterfaceUserWidget->InitColorMaps(GI->Config, Mins, Maxs);
+	HUD->UserInterfaceUserWidget->InitColorMaps(GI->Config, QuantityMins, QuantityMaxs);
 	HUD->UserInterfaceUserWidget->AddSimulationController(Simulation);
 
 	// Update the colormaps for all assets in each simulation, to draw the correct colors for each value
 	for (ASimulation* Sim : Simulations)
-		Sim->UpdateColorMaps(Mins, Maxs);
+		Sim->UpdateColorMaps(QuantityMins, QuantityMaxs);
 }
 
 void UVRSSGameInstanceSubsystem::ToggleHUDVisibility() const
@@ -80,14 +89,13 @@ void UVRSSGameInstanceSubsystem::ToggleHUDVisibility() const
 
 void UVRSSGameInstanceSubsystem::OnActiveAssetsChanged() const
 {
-	TSet<FString> ActiveQuantities = TSet<FString>();
-	for (const ASimulation* Sim : Simulations)
-		ActiveQuantities.Append(Sim->GetQuantities(true));
+	TArray<FString> ActiveQuantities = TArray<FString>();
+	ActiveQuantityCounts.GetKeys(ActiveQuantities);
 
 	const APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
 	AHUD* HUD = PC->GetHUD();
 	UUserInterfaceUserWidget* UW = Cast<AVRSSHUD>(HUD)->UserInterfaceUserWidget;
-	UW->UpdateColorMaps(ActiveQuantities.Array());
+	UW->UpdateColorMaps(ActiveQuantities);
 }
 
 void UVRSSGameInstanceSubsystem::ChangeObstQuantity(FString& NewQuantity)
@@ -99,3 +107,42 @@ void UVRSSGameInstanceSubsystem::ChangeObstQuantity(FString& NewQuantity)
 		Sim->ChangeObstQuantity(NewQuantity);
 	}
 }
+
+void UVRSSGameInstanceSubsystem::AddActiveQuantity(const FString& Quantity)
+{
+	++ActiveQuantityCounts.FindOrAdd(Quantity);
+}
+
+void UVRSSGameInstanceSubsystem::RemoveActiveQuantity(const FString& Quantity)
+{
+	int* Count = ActiveQuantityCounts.Find(Quantity);
+	if (!Count) return;
+	if (--*Count <= 0) ActiveQuantityCounts.Remove(Quantity);
+}
+
+TArray<FSimulationMemoryUsage> UVRSSGameInstanceSubsystem::GetMemoryUsage() const
+{
+	TArray<FSimulationMemoryUsage> MemoryUsage;
+	for (const ASimulation* Sim : Simulations)
+		MemoryUsage.Add(Sim->GetMemoryUsage());
+	return MemoryUsage;
+}
+
+void UVRSSGameInstanceSubsystem::LogMemoryUsage(const bool bPerActor) const
+{
+	const auto ToMegabytes = [](const int64 Bytes) { return Bytes / (1024.f * 1024.f); };
+
+	for (const FSimulationMemoryUsage& Usage : GetMemoryUsage())
+	{
+		UE_LOG(LogVRSSMemory, Display, TEXT("%s: %.2f MB CPU, %.2f MB GPU"), *Usage.SimulationName,
+		       ToMegabytes(Usage.Total.CpuBytes), ToMegabytes(Usage.Total.GpuBytes));
+		for (const TPair<FString, FVRSSMemoryUsage>& TypeUsage : Usage.PerType)
+			UE_LOG(LogVRSSMemory, Display, TEXT("  %s: %.2f MB CPU, %.2f MB GPU"), *TypeUsage.Key,
+			       ToMegabytes(TypeUsage.Value.CpuBytes), ToMegabytes(TypeUsage.Value.GpuBytes));
+		if (!bPerActor) continue;
+
+		for (const TPair<FString, FVRSSMemoryUsage>& ActorUsage : Usage.PerActor)
+			UE_LOG(LogVRSSMemory, Display, TEXT("    %s: %.2f MB CPU, %.2f MB GPU"), *ActorUsage.Key,
+			       ToMegabytes(ActorUsage.Value.CpuBytes), ToMegabytes(ActorUsage.Value.GpuBytes));
+	}
+}
@@ -0,0 +1,44 @@
+#include "VRSSStats.h"
+
+
+UE_TRACE_CHANNEL_DEFINE(VRSmokeVisChannel);
+
+DEFINE_STAT(STAT_VRSS_RegisterTextureLoad);
+DEFINE_STAT(STAT_VRSS_NextTimeStep);
+DEFINE_STAT(STAT_VRSS_LoadUnloadTimeStep);
+DEFINE_STAT(STAT_VRSS_UpdateObst);
+DEFINE_STAT(STAT_VRSS_UpdateSlice);
+DEFINE_STAT(STAT_VRSS_UpdateVolume);
+DEFINE_STAT(STAT_VRSS_ReadTimeSeries);
+DEFINE_STAT(STAT_VRSS_Activate);
+DEFINE_STAT(STAT_VRSS_Deactivate);
+
+DEFINE_STAT(STAT_VRSS_Parse);
+DEFINE_STAT(STAT_VRSS_ReadData);
+DEFINE_STAT(STAT_VRSS_Convert);
+DEFINE_STAT(STAT_VRSS_CreateTexture);
+DEFINE_STAT(STAT_VRSS_SavePackage);
+
+DEFINE_STAT(STAT_VRSS_TexturesResident);
+DEFINE_STAT(STAT_VRSS_TextureRequests);
+DEFINE_STAT(STAT_VRSS_TextureMisses);
+DEFINE_STAT(STAT_VRSS_StreamedMegabytesPerSecond);
+DEFINE_STAT(STAT_VRSS_ObstGeometryInstances);
+
+
+void FVRSSStats::AddStreamedBytes(const int64 NumBytes)
+{
+#if STATS
+	static double IntervalStartTime = FPlatformTime::Seconds();
+	static int64 IntervalBytes = 0;
+
+	IntervalBytes += NumBytes;
+	const double Now = FPlatformTime::Seconds();
+	if (Now - IntervalStartTime >= 1)
+	{
+		SET_FLOAT_STAT(STAT_VRSS_StreamedMegabytesPerSecond, IntervalBytes / (Now - IntervalStartTime) / (1024 * 1024));
+		IntervalStartTime = Now;
+		IntervalBytes = 0;
+	}
+#endif
+}
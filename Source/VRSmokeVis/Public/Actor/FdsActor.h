@@ -7,6 +7,44 @@
 #include "FdsActor.generated.h"
 
 
+/**
+ * A single stream of textures (one per timestep) that is played back by an actor, e.g. one face of an obstruction or
+ * a whole slice.
+ */
+struct FFdsTextureChannel
+{
+	/** Orientation of the face for obstructions, 0 for slices and volumes */
+	int Orientation = 0;
+
+	/** Size of the data in cells (w equals the number of timesteps) */
+	FVector4 Dimensions;
+
+	/** Paths to the textures of all timesteps, ordered by timestep. Empty if the actor uses shared atlas textures. Points
+	 * into the texture path table of the DataAsset instead of copying it, so it has to be rebuilt with the descriptor
+	 * whenever that table changes */
+	TArrayView<const FSoftObjectPath> TexturePaths;
+
+	/** Number of consecutive timesteps stored in the layers of each texture, 1 unless the textures are texture arrays */
+	int TimeStepsPerTexture = 1;
+
+	/** Position (xy) and size (zw) of the data inside the texture in UV space, only differs from the default for atlases */
+	FVector4 AtlasRect = FVector4(0, 0, 1, 1);
+};
+
+/**
+ * Flat description of all the data an actor streams during playback. It is built once when the actor is activated, so
+ * the per-timestep logic neither has to cast the DataAsset nor look up (nested) maps.
+ */
+struct FFdsPlaybackDescriptor
+{
+	/** One channel per face for obstructions, exactly one channel for slices and volumes */
+	TArray<FFdsTextureChannel, TInlineAllocator<6>> Channels;
+
+	/** Atlas textures shared by all channels (and actors), ordered by timestep. These are streamed once for all actors
+	 * by the simulation instead of per channel */
+	const TArray<FSoftObjectPath>* AtlasTexturePaths = nullptr;
+};
+
 /**
  * Abstract base class for any actor that displays data from FDS, such as slices, obstructions or smoke volumes.
  */
@@ -16,7 +54,55 @@ class VRSMOKEVIS_API AFdsActor : public AActor
 	GENERATED_BODY()
 	
 public:
+	/** (Re-)Builds the PlaybackDescriptor from the DataAsset, has to be called after the textures have been registered */
+	virtual void BuildPlaybackDescriptor() PURE_VIRTUAL(AFdsActor::BuildPlaybackDescriptor, );
+
 	/** The loaded asset belonging to this actor */
 	UPROPERTY(BlueprintReadOnly)
 	class UFdsDataAsset* DataAsset;
+
+	/** Everything needed to stream and display the data of this actor, valid while the actor is active */
+	FFdsPlaybackDescriptor PlaybackDescriptor;
+
+	/** The transient textures the time series is streamed into, empty unless the actor has been shown at least once */
+	const TArray<UTexture*>& GetTimeSeriesTextures() const { return TimeSeriesTextures; }
+
+protected:
+#if WITH_EDITOR
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Rebuilds the PlaybackDescriptor of an active actor once its DataAsset has been changed (e.g. reimported), as the
+	 * channels point into the texture path tables of the asset */
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
+	FDelegateHandle ObjectPropertyChangedHandle;
+#endif
+
+	/** Advances the ring of time series textures by one, so the texture of the next timestep becomes the one of
+	 * the current timestep, and streams the given and following timesteps into the remaining textures. Only valid if
+	 * the DataAsset has been imported as a time series */
+	void StreamTimeSeries(const int NextTimeStep);
+
+	/** The texture containing the current timestep */
+	UTexture* GetTimeSeriesTextureT0() const;
+
+	/** The texture containing the next timestep */
+	UTexture* GetTimeSeriesTextureT1() const;
+
+	/** Number of transient textures the time series is streamed into. Two of them are displayed, the others are
+	 * filled ahead of time */
+	static constexpr int NumTimeSeriesTextures = 4;
+
+	/** Ring of transient textures the time series of the DataAsset is streamed into. They are created once and only
+	 * their content is updated each timestep */
+	UPROPERTY(Transient)
+	TArray<UTexture*> TimeSeriesTextures;
+
+	/** The timestep whose data has been requested for each of the TimeSeriesTextures */
+	TArray<int> TimeSeriesTextureTimeSteps;
+
+	/** Index of the texture containing the current timestep in TimeSeriesTextures */
+	int TimeSeriesRingHead = 0;
 };
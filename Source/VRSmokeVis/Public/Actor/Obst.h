@@ -28,18 +28,31 @@ public:
 
 	/** Delegate to update the ColorMap in case a simulation with obsts with higher Max/lower Min has been added */
 	UFUNCTION()
-	void UpdateColorMapScale(const float NewMin, const float NewMax) const;
+	void UpdateColorMapScale(const float NewMin, const float NewMax);
+
+	/** Creates the dynamic material instances for all faces. Only called when the obst is activated for the first time,
+	 * as inactive obsts are never rendered and don't need any materials */
+	UFUNCTION()
+	void InitDataMaterials();
 
 	UFUNCTION()
 	void SetActiveQuantity(FString GlobalObstQuantity);
 
-	/** Delegate to update the texture after a given amount of time */
+	/** Delegate to update the textures of all faces after a given amount of time */
 	UFUNCTION()
-	void UpdateTexture(const int CurrentTimeStep, const int Orientation);
+	void UpdateTexture(const int CurrentTimeStep);
+
+	virtual void BuildPlaybackDescriptor() override;
 
 protected:
 	virtual void BeginPlay() override;
 
+	/** Sets the quantity dependent parameters (CutOffValue and ColorMap) of all existing dynamic material instances */
+	void UpdateQuantityParameters();
+
+	/** Sets the position of each face inside its texture (the whole texture unless an atlas is used) in the materials */
+	void UpdateAtlasRects();
+
 public:
 	/** The base material for obst data */
 	UPROPERTY(BlueprintReadOnly, EditAnywhere)
@@ -55,6 +68,10 @@ protected:
 	UPROPERTY()
 	class ASimulation* Sim;
 
+	/** The value range of the ColorMap set by the last call to UpdateColorMapScale */
+	float ColorMapScaleMin = 0;
+	float ColorMapScaleMax = 0;
+
 	/** The % of time that has passed until the next frame is reached */
 	UPROPERTY(VisibleAnywhere)
 	float TimePassedPercentage = 0;
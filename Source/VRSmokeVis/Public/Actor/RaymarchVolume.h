@@ -30,6 +30,8 @@ public:
 	UFUNCTION()
 	void UpdateVolume(const int CurrentTimeStep);
 
+	virtual void BuildPlaybackDescriptor() override;
+
 protected:
 	virtual void BeginPlay() override;
 
@@ -60,6 +62,13 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Transient)
 	UVolumeTexture* DataVolumeTextureT1;
 
+	/** Index of the current and next timestep inside of their volume textures, in case multiple timesteps are stacked
+	 * along the z-axis of each texture */
+	UPROPERTY(VisibleAnywhere)
+	int SubStepT0 = 0;
+	UPROPERTY(VisibleAnywhere)
+	int SubStepT1 = 0;
+
 	/** Dynamic material instance for intensity rendering */
 	UPROPERTY(BlueprintReadOnly, Transient)
 	UMaterialInstanceDynamic* RaymarchMaterial;
@@ -1,13 +1,84 @@
 ﻿#pragma once
 
 #include "Engine/StreamableManager.h"
+#include "Util/PlaybackBenchmark.h"
 #include "Simulation.generated.h"
 
 DECLARE_EVENT_OneParam(UVRSSGameInstance, FUpdateDataEvent, int)
+DECLARE_EVENT_OneParam(ASimulation, FSimulationInitializedEvent, class ASimulation*)
+DECLARE_EVENT_OneParam(ASimulation, FPlaybackBenchmarkFinishedEvent, const FPlaybackBenchmarkResults&)
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSimulation, Log, All);
 
 
+/**
+ * Statistics collected while playing back a simulation.
+ */
+USTRUCT(BlueprintType)
+struct FPlaybackStats
+{
+	GENERATED_BODY()
+
+	/** Number of timesteps for which textures have been streamed (summed up over all types) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 NumStreamedTimeSteps = 0;
+
+	/** Number of textures that have been requested to be loaded asynchronously */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 NumTextureRequests = 0;
+
+	/** Number of heap allocations made by LoadUnloadTimeStep: growing one of its reused buffers and the copy of the
+	 * paths the StreamableManager keeps for each request. Once the buffers have grown, only timesteps that request
+	 * textures allocate, once for their request */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 NumStreamingAllocations = 0;
+};
+
+/**
+ * Memory used by the data of a simulation in bytes, split into system (CPU) and video (GPU) memory.
+ */
+USTRUCT(BlueprintType)
+struct FVRSSMemoryUsage
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 CpuBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 GpuBytes = 0;
+
+	FVRSSMemoryUsage& operator+=(const FVRSSMemoryUsage& Other)
+	{
+		CpuBytes += Other.CpuBytes;
+		GpuBytes += Other.GpuBytes;
+		return *this;
+	}
+};
+
+/**
+ * Memory used by the textures that are currently resident for a single simulation.
+ */
+USTRUCT(BlueprintType)
+struct FSimulationMemoryUsage
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FString SimulationName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FVRSSMemoryUsage Total;
+
+	/** Keyed by "Obst", "Slice" and "Volume" */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	TMap<FString, FVRSSMemoryUsage> PerType;
+
+	/** Keyed by the name of the actor. The atlas textures shared by all obstructions are listed as "ObstAtlas" */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	TMap<FString, FVRSSMemoryUsage> PerActor;
+};
+
 /**
  * 
  */
@@ -50,7 +121,8 @@ public:
 	UFUNCTION()
 	TArray<class ARaymarchVolume*>& GetAllVolumes();
 
-	/** Gets called from GameInstanceSubsystem */
+	/** Gets called from GameInstanceSubsystem. Prefetches the textures of the new quantity the active obstructions need
+	 * around the current timestep in the background, the obstructions switch to it once all of them have been loaded */
 	UFUNCTION()
 	void ChangeObstQuantity(const FString& NewQuantity);
 
@@ -80,22 +152,88 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void GetObstructionsMaxMinForQuantity(FString Quantity, float& MinOut, float& MaxOut) const;
 
-	/** Spawn meshes for each obstruction with size and location originating from the fds simulation */
+	/** Returns the atlas textures of all obstruction faces for the given quantity or nullptr if there is no atlas */
+	const TArray<FSoftObjectPath>* GetObstAtlasTexturePaths(const FString& Quantity) const;
+
+	/** Returns how far the (asynchronous) initialization of the simulation has progressed, between 0 and 1 */
+	UFUNCTION(BlueprintCallable)
+	float GetInitProgress() const;
+
+	/** Whether all data assets have been loaded and all obstructions, slices and volumes have been spawned */
+	UFUNCTION(BlueprintCallable)
+	bool IsInitialized() const;
+
+	/** Add an instance for each obstruction with size and location originating from the fds simulation */
 	UFUNCTION(CallInEditor, Category="Simulation")
 	void SpawnSimulationGeometry();
 
+	/** Returns the number of obstruction cuboids rendered by the instanced geometry component. Each of them used to be
+	 * a separate actor */
+	UFUNCTION(BlueprintCallable)
+	int GetNumObstGeometryInstances() const;
+
+	/** Activates the chosen obstructions, slices and volumes and plays back all timesteps from the beginning, while
+	 * collecting statistics about the streaming. The benchmark ends as soon as the simulation starts over. Can also be
+	 * started by passing -PlaybackBenchmark on the command line, see FPlaybackBenchmarkSettings for further parameters */
+	UFUNCTION(BlueprintCallable)
+	void StartPlaybackBenchmark(const FPlaybackBenchmarkSettings& Settings);
+
+	UFUNCTION(BlueprintCallable)
+	bool IsPlaybackBenchmarkRunning() const;
+
+	/** Returns the memory used by all textures streamed by this simulation and the time series textures of its actors */
+	UFUNCTION(BlueprintCallable)
+	FSimulationMemoryUsage GetMemoryUsage() const;
+
+	/** Returns the memory used by a loaded texture */
+	static FVRSSMemoryUsage GetTextureMemoryUsage(class UTexture* Texture);
+
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION()
 	void NextTimeStep(const FString Type);
 
 	UFUNCTION()
 	void LoadUnloadTimeStep(int TimeStep, const FString& Type);
 
+	/** Makes sure the textures in the (ordered) path table exist and loads the first few of them synchronously. Each
+	 * texture may contain multiple consecutive timesteps as layers of a texture array. Atlas textures are shared by all
+	 * obstructions and are therefore not accounted to the actor registering them */
 	UFUNCTION()
-	bool RegisterTextureLoad(const FString Type, const AActor* Asset, const FString& TextureDirectory,
-	                         UPARAM(ref) TArray<FAssetData>& TextureArray, const int NumTextures);
+	bool RegisterTextureLoad(const FString Type, const AActor* Asset, const TArray<FSoftObjectPath>& TexturePaths,
+	                         const int NumTimeSteps, const int TimeStepsPerTexture = 1, const bool bIsAtlas = false);
+
+	/** Makes sure the sidecar file of an actor that has been imported as a time series exists */
+	bool RegisterTimeSeries(const class AFdsActor* Actor) const;
+
+	/** Whether the textures of the given timestep of all active actors of a type have been loaded. Time series are
+	 * streamed by the actors themselves and are therefore not taken into account */
+	bool IsTimeStepResident(const int TimeStep, const FString& Type) const;
+
+	/** Reports the results of the running playback benchmark and stops it */
+	void FinishPlaybackBenchmark();
+
+	/** Called once the textures of a request of LoadUnloadTimeStep have been loaded, frees its request slot */
+	void OnTexturesStreamed(const int32 RequestIndex);
+
+	/** Shows the new quantity on all obstructions and releases the textures of the old one. Called in a single frame
+	 * once the textures prefetched by ChangeObstQuantity have been loaded */
+	void SwapObstQuantity(const FString NewQuantity);
+
+	/** Calls the function for each texture of the quantity that the active obstructions need around the current
+	 * timestep. Owner is null for atlas textures */
+	void ForEachObstWindowTexture(const FString& Quantity,
+	                              TFunctionRef<void(const FSoftObjectPath&, const AObst*)> Function) const;
+
+	/** Keeps track of the textures loaded and unloaded by the StreamableManager. Owner is null for atlas textures */
+	void AddResidentTexture(const FSoftObjectPath& TexturePath, const FString& Type, const AActor* Owner);
+	void RemoveResidentTexture(const FSoftObjectPath& TexturePath);
+
+	/** Unloads all resident textures of the type, only those of the given actor unless ActorName is none */
+	void ReleaseResidentTextures(const FName Type, const FName ActorName = NAME_None);
 
 	UFUNCTION()
 	void ActivateObst(AObst* Obst);
@@ -110,12 +248,27 @@ protected:
 	UFUNCTION()
 	void DeactivateVolume(ARaymarchVolume* Volume);
 
+	/** Returns the paths of all assets of the given type listed in the manifest of the simulation asset */
+	const TArray<FSoftObjectPath>& GetAssetPaths(const FString& Type);
+
+	/** Called as soon as all data assets of the simulation have been loaded asynchronously */
+	void OnDataAssetsLoaded();
+
+	/** Spawns the next batch of actors and schedules itself for the next frame until all actors have been spawned */
 	UFUNCTION()
-	void InitObstructions();
+	void SpawnNextActors();
+
+	/** Computes the value range of each quantity over all slices and obstructions, once all actors have been spawned */
+	void BuildQuantityRanges();
+
+	UFUNCTION()
+	void InitActiveObstQuantity();
 	UFUNCTION()
-	void InitSlices();
+	void InitObst(const FSoftObjectPath& ObstPath);
 	UFUNCTION()
-	void InitVolumes();
+	void InitSlice(const FSoftObjectPath& SlicePath);
+	UFUNCTION()
+	void InitVolume(const FSoftObjectPath& VolumePath);
 
 public:
 	/** The loaded slice asset belonging to this slice */
@@ -155,6 +308,23 @@ public:
 	UPROPERTY(BlueprintReadOnly)
 	class USimControllerUserWidget* SimControllerUserWidget;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FPlaybackStats PlaybackStats;
+
+	/** The maximum number of obstructions, slices and volumes that are spawned per frame during initialization */
+	UPROPERTY(EditAnywhere)
+	int MaxActorsSpawnedPerFrame = 64;
+
+	/** The time in milliseconds that may be spent spawning actors per frame during initialization */
+	UPROPERTY(EditAnywhere)
+	float SpawnFrameBudgetMs = 4;
+
+	/** Broadcast once all actors of the simulation have been spawned */
+	FSimulationInitializedEvent SimulationInitializedEvent;
+
+	/** Broadcast once a playback benchmark has finished */
+	FPlaybackBenchmarkFinishedEvent PlaybackBenchmarkFinishedEvent;
+
 protected:
 	/** Lists of currently inactive obstructions */
 	UPROPERTY(VisibleAnywhere)
@@ -166,12 +336,91 @@ protected:
 	UPROPERTY(VisibleAnywhere)
 	TArray<class ARaymarchVolume*> Volumes;
 
+	/** Lists of currently active obstructions, slices and volumes. These are maintained by the Activate* and
+	 * Deactivate* functions, so any per-timestep logic only has to iterate over the actors that are actually shown */
+	UPROPERTY(VisibleAnywhere)
+	TArray<class AObst*> ActiveObstructions;
+	UPROPERTY(VisibleAnywhere)
+	TArray<class ASlice*> ActiveSlices;
+	UPROPERTY(VisibleAnywhere)
+	TArray<class ARaymarchVolume*> ActiveVolumes;
+
+	/** Value range of each quantity over all slices and obstructions of this simulation. The data assets don't change
+	 * at runtime, so the ranges are only computed once in BuildQuantityRanges instead of on each request */
+	TMap<FString, float> QuantityMins;
+	TMap<FString, float> QuantityMaxs;
+
+	/** The unique quantities of all slices */
+	TArray<FString> SliceQuantities;
+
+	/** Number of active slices per quantity, maintained by ActivateSlice and DeactivateSlice */
+	TMap<FString, int> ActiveSliceQuantities;
+
+	/** Renders the geometry of all obstructions, the custom data of each instance is the index of the obstruction */
+	UPROPERTY(VisibleAnywhere)
+	class UHierarchicalInstancedStaticMeshComponent* ObstGeometryComponent;
+
 	/** Used to asynchronously load assets at runtime */
 	FStreamableManager StreamableManager;
 
+	/** Keeps the data assets loaded until all actors have been spawned */
+	TSharedPtr<FStreamableHandle> DataAssetsHandle;
+
+	/** The quantity shown by all obstructions. Differs from the configured one while the textures of a new quantity
+	 * are still being prefetched */
+	UPROPERTY(VisibleAnywhere)
+	FString ObstQuantity;
+
+	/** Keeps the textures prefetched for a pending switch of the obstruction quantity loading */
+	TSharedPtr<FStreamableHandle> ObstQuantitySwitchHandle;
+
+	int NumActorsToSpawn = 0;
+	int NumSpawnedActors = 0;
+	double InitStartTime = 0;
+
+	UPROPERTY(VisibleAnywhere)
+	bool bIsInitialized = false;
+
+	/** Paths of the textures that are requested in LoadUnloadTimeStep. Kept as a member and only reset each timestep, so
+	 * the memory is reused instead of being allocated again */
+	TArray<FSoftObjectPath> PendingTextureLoads;
+
+	/** A texture request of LoadUnloadTimeStep that has not finished yet */
+	struct FStreamingRequest
+	{
+		double RequestTime = 0;
+		/** The requested textures, including those that were still in memory */
+		TArray<FSoftObjectPath> StreamedTextures;
+	};
+
+	/** Slots for the requests of LoadUnloadTimeStep, which are reused once their request has finished, so the memory of
+	 * their arrays is reused as well */
+	TArray<FStreamingRequest> StreamingRequests;
+	TArray<int32> FreeStreamingRequests;
+
+	/** The type and actor a resident texture has been loaded for */
+	struct FResidentTexture
+	{
+		FName Type;
+		FName ActorName;
+	};
+
+	/** Textures that are currently kept loaded by the StreamableManager, i.e. that have been loaded for one of the
+	 * upcoming timesteps and not been unloaded yet */
+	TMap<FSoftObjectPath, FResidentTexture> ResidentTextures;
+
 	/** Handles to manage the update timer */
 	TMap<FString, FTimerHandle> UpdateTimerHandles;
 
+	/** Collects the statistics of the running playback benchmark, null if there is none */
+	TUniquePtr<FPlaybackBenchmark> PlaybackBenchmark;
+
+	/** Set once the simulation starts over, the benchmark is finished at the end of the current timestep */
+	bool bFinishPlaybackBenchmark = false;
+
+	/** Timers of the jumps of the running playback benchmark */
+	TArray<FTimerHandle> SeekBurstTimerHandles;
+
 	TMap<FString, FUpdateDataEvent> UpdateDataEvents;
 
 	UPROPERTY(BlueprintReadOnly)
@@ -181,7 +430,7 @@ protected:
 	bool bIsPaused = false;
 
 	/** Maps actor names (obsts, slices and volumes) to DelegateHandles for the texture update event */
-	TMap<FString, TMap<int, FDelegateHandle>> ObstUpdateDataEventDelegateHandles;
+	TMap<FString, FDelegateHandle> ObstUpdateDataEventDelegateHandles;
 	TMap<FString, FDelegateHandle> SliceUpdateDataEventDelegateHandles;
 	TMap<FString, FDelegateHandle> VolumeUpdateDataEventDelegateHandles;
 };
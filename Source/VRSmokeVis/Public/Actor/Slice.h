@@ -32,9 +32,14 @@ public:
 	UFUNCTION()
 	void UpdateTexture(const int CurrentTimeStep);
 
+	virtual void BuildPlaybackDescriptor() override;
+
 protected:
 	virtual void BeginPlay() override;
 
+	/** Sets the texture array and layer of the next timestep if the slice is stored as texture arrays */
+	void UpdateTextureArrayLayer(const int NextTimeStep);
+
 public:
 	/** The base material for slice rendering */
 	UPROPERTY(BlueprintReadOnly, EditAnywhere)
@@ -59,6 +64,20 @@ protected:
 	/** Next data texture */
 	UPROPERTY(BlueprintReadOnly, Transient)
 	UTexture2D* DataTextureT1;
+
+	/** Texture array containing the current timestep, only used if the slice is stored as texture arrays */
+	UPROPERTY(BlueprintReadOnly, Transient)
+	class UTexture2DArray* DataTextureArrayT0;
+
+	/** Texture array containing the next timestep, only used if the slice is stored as texture arrays */
+	UPROPERTY(BlueprintReadOnly, Transient)
+	class UTexture2DArray* DataTextureArrayT1;
+
+	/** Layers of the current and next timestep inside of their texture arrays */
+	UPROPERTY(VisibleAnywhere)
+	int DataLayerT0 = 0;
+	UPROPERTY(VisibleAnywhere)
+	int DataLayerT1 = 0;
 	
 	/** MeshComponent that contains the slice plane */
 	UPROPERTY(EditDefaultsOnly)
@@ -27,6 +27,9 @@ public:
 	/** Returns the number of bytes needed to store a specific face */
 	int64 GetByteSize(const int Face) const;
 
+	/** Returns the number of bytes needed to store a single timestep of a specific face */
+	int64 GetTimeStepByteSize(const int Face) const;
+
 	virtual int64 GetByteSize() const override;
 
 	virtual FString ToString() const override;
@@ -63,4 +66,8 @@ public:
 	* to an original value of 200. */
 	UPROPERTY(VisibleAnywhere)
 	TMap<FString, float> ScaleFactors;
+
+	/** Statistics of all faces for each quantity whose data has been read. Faces are too small to be split into bricks */
+	UPROPERTY(VisibleAnywhere)
+	TMap<FString, FDataStatistics> Statistics;
 };
@@ -2,6 +2,74 @@
 
 #include "DataInfo.generated.h"
 
+/**
+ * Statistics of the stored (0-255) values of an asset, computed once while importing its data. These are the normalized
+ * values for obstructions and slices and the transmissions (255 for empty cells) for volumes. They describe each
+ * timestep and each brick (a block of cells) of each timestep, so the data doesn't have to be touched at runtime to
+ * find out about its value range or whether parts of it are empty.
+ */
+USTRUCT(BlueprintType)
+struct VRSMOKEVIS_API FDataStatistics
+{
+	GENERATED_BODY()
+
+	/** Maximum size of a brick in cells along each axis, bricks at the border of the data may be smaller */
+	static constexpr int MaxBrickSize = 16;
+
+	/** Whether the statistics have been computed, which is only the case once the data has been read */
+	bool IsValid() const;
+
+	int GetNumTimeSteps() const;
+
+	/** Whether all values of a timestep equal EmptyValue, which is 255 for volumes */
+	bool IsTimeStepEmpty(const int TimeStep, const uint8 EmptyValue = 0) const;
+
+	/** Whether all values of a brick of a timestep equal EmptyValue, which is 255 for volumes. Bricks are indexed x
+	 * first, then y, then z */
+	bool IsBrickEmpty(const int TimeStep, const int Brick, const uint8 EmptyValue = 0) const;
+
+	/** Returns the lowest and highest value over all timesteps */
+	void GetValueRange(uint8& OutMin, uint8& OutMax) const;
+
+	/** Returns the lowest value that is larger than or equal to the given share (0-1) of all values */
+	uint8 GetPercentile(const float Percentile) const;
+
+	/** Adds the value ranges and histogram of other statistics of the same number of timesteps, e.g. of another face
+	 * of an obstruction. The bricks can't be combined and are therefore dropped */
+	void Merge(const FDataStatistics& Other);
+
+	/** Adds the timesteps of other statistics after the ones of these, e.g. of the next texture of a volume that is
+	 * imported one texture at a time. Both have to describe data of the same dimensions, so the bricks are kept */
+	void Append(const FDataStatistics& Other);
+
+	/** Converts a stored value back to the value of the quantity, given the range the data has been normalized to */
+	static float ToValue(const uint8 StoredValue, const float MinValue, const float MaxValue);
+
+	/** Lowest and highest value of each timestep */
+	UPROPERTY(VisibleAnywhere)
+	TArray<uint8> TimeStepMins;
+	UPROPERTY(VisibleAnywhere)
+	TArray<uint8> TimeStepMaxs;
+
+	/** Size of a brick in cells */
+	UPROPERTY(VisibleAnywhere)
+	FIntVector BrickSize = FIntVector::ZeroValue;
+
+	/** Number of bricks along each axis */
+	UPROPERTY(VisibleAnywhere)
+	FIntVector NumBricks = FIntVector::ZeroValue;
+
+	/** Lowest and highest value of each brick of each timestep, all bricks of the first timestep come first */
+	UPROPERTY(VisibleAnywhere)
+	TArray<uint8> BrickMins;
+	UPROPERTY(VisibleAnywhere)
+	TArray<uint8> BrickMaxs;
+
+	/** Number of occurrences of each of the 256 values over all timesteps */
+	UPROPERTY(VisibleAnywhere)
+	TArray<int64> Histogram;
+};
+
 /**
  * Contains information about the data loaded from the binary data and yaml header file.
  */
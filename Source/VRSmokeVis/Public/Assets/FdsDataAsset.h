@@ -18,4 +18,9 @@ public:
 	/** Holds the general info about the Yaml Data read from disk */
 	UPROPERTY(EditAnywhere)
 	UDataInfo* DataInfo;
+
+	/** The data of all timesteps in a single sidecar file, set instead of the texture paths if the asset has been
+	 * imported as a time series */
+	UPROPERTY(VisibleAnywhere)
+	class UFdsTimeSeriesAsset* TimeSeries = nullptr;
 };
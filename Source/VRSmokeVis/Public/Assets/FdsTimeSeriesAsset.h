@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Util/StagingBufferPool.h"
+
+#include "FdsTimeSeriesAsset.Generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogFdsTimeSeries, Log, All);
+
+
+/**
+ * Lightweight alternative to one texture asset per timestep. The raw data of all timesteps is kept in a single sidecar
+ * file below DataDirectory and each timestep is read asynchronously when it is needed.
+ */
+UCLASS()
+class VRSMOKEVIS_API UFdsTimeSeriesAsset : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Directory below the content directory the sidecar files are written to. Cooking only packages assets, so it is
+	 * staged as loose files by DirectoriesToAlwaysStageAsNonUFS in DefaultGame.ini */
+	static const TCHAR* DataDirectory;
+
+	/** Returns the absolute path of the sidecar file, in the editor as well as in packaged builds */
+	FString GetDataFilePath() const;
+
+	/** Whether the sidecar file exists */
+	bool HasDataFile() const;
+
+	int GetNumTimeSteps() const;
+
+	/** Reads the data of the given timestep from the sidecar file on a worker thread. OnRead is called on the game
+	 * thread once the data is available and is not called at all if the data could not be read */
+	void ReadTimeStepAsync(const int TimeStep, TFunction<void(FStagingBuffer&&)>&& OnRead) const;
+
+	/** Path of the sidecar file relative to the content directory, starting with DataDirectory */
+	UPROPERTY(VisibleAnywhere)
+	FString DataFileName;
+
+	/** Size of the texture a single timestep is streamed into */
+	UPROPERTY(VisibleAnywhere)
+	FIntVector Dimensions;
+
+	/** Byte offsets of all timesteps in the sidecar file, followed by the size of the file */
+	UPROPERTY(VisibleAnywhere)
+	TArray<int64> TimeStepOffsets;
+};
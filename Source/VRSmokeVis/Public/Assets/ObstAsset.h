@@ -13,8 +13,9 @@ struct FFixedFaceObstTextures
 {
 	GENERATED_BODY()
 
+	/** Paths to the textures, ordered by timestep. Written by the importer, so no lookup or sorting is needed at runtime */
 	UPROPERTY()
-	TArray<FAssetData> Textures;
+	TArray<FSoftObjectPath> Textures;
 };
 
 /**
@@ -42,6 +43,11 @@ public:
 	UPROPERTY()
 	TMap<FString, FFixedQuantityObstTextures> ObstTextures;
 
+	/** Position (xy) and size (zw) of each face inside the obstruction atlas textures of the simulation in UV space.
+	 * Only set if the simulation has been imported with an obstruction atlas */
+	UPROPERTY()
+	TMap<int, FVector4> AtlasRects;
+
 	/** The bounding box of the cuboid defined by the obst */
 	UPROPERTY(EditAnywhere)
 	TArray<float> BoundingBox;
@@ -5,6 +5,19 @@
 #include "SimulationAsset.generated.h"
 
 
+/**
+ * Struct containing the atlas textures of all obstruction faces for a fixed quantity and multiple timesteps.
+ */
+USTRUCT()
+struct FObstAtlasTextures
+{
+	GENERATED_BODY()
+
+	/** Paths to the atlas textures, ordered by timestep */
+	UPROPERTY()
+	TArray<FSoftObjectPath> Textures;
+};
+
 /**
  * DataAsset containing data about a whole FDS simulation.
  */
@@ -21,10 +34,17 @@ public:
 	UPROPERTY(VisibleAnywhere)
 	TMap<FString, FString> AssetDirectories;
 
-	UPROPERTY(VisibleAnywhere, Transient)
-	TArray<FAssetData> Obstructions;
-	UPROPERTY(VisibleAnywhere, Transient)
-	TArray<FAssetData> Slices;
-	UPROPERTY(VisibleAnywhere, Transient)
-	TArray<FAssetData> Volumes;
+	/** Manifest of all obstruction, slice and volume assets of this simulation, written by the importer. Allows spawning
+	 * the simulation without scanning the asset directories */
+	UPROPERTY(VisibleAnywhere)
+	TArray<FSoftObjectPath> Obstructions;
+	UPROPERTY(VisibleAnywhere)
+	TArray<FSoftObjectPath> Slices;
+	UPROPERTY(VisibleAnywhere)
+	TArray<FSoftObjectPath> Volumes;
+
+	/** Atlas textures containing the boundary data of all obstructions per quantity. Empty if the simulation has been
+	 * imported without an obstruction atlas, each face then has its own textures instead */
+	UPROPERTY(VisibleAnywhere)
+	TMap<FString, FObstAtlasTextures> ObstAtlasTextures;
 };
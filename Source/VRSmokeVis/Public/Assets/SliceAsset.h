@@ -14,6 +14,7 @@ class VRSMOKEVIS_API USliceAsset : public UFdsDataAsset
 	GENERATED_BODY()
 
 public:
+	/** Paths to the slice textures, ordered by timestep. Written by the importer when creating the asset */
 	UPROPERTY()
-	TArray<FAssetData> SliceTextures;
+	TArray<FSoftObjectPath> SliceTextures;
 };
@@ -18,6 +18,11 @@ public:
 	/** Returns the number of cells in this slice */
 	int64 GetTotalCells() const;
 
+	/** Returns the size of the slice in cells as integers */
+	FIntVector GetCellDimensions() const;
+
+	int GetNumTimeSteps() const;
+
 	virtual FString ToString() const override;
 	
 	/** Name of the slice file that was loaded */
@@ -40,6 +45,11 @@ public:
 	UPROPERTY(VisibleAnywhere)
 	FVector4 Dimensions;
 
+	/** Number of timesteps stored as layers of a single texture array. 0 if the slice has been imported with one 2D
+	 * texture per timestep */
+	UPROPERTY(VisibleAnywhere)
+	int TimeStepsPerTexture = 0;
+
 	/** Size of a cell in mm (w equals time in seconds)  */
 	UPROPERTY(VisibleAnywhere)
 	FVector4 Spacing;
@@ -64,4 +74,8 @@ public:
 	* an original value of 200 */
 	UPROPERTY(VisibleAnywhere)
 	float ScaleFactor;
+
+	/** Statistics of the data, invalid until the data has been read */
+	UPROPERTY(VisibleAnywhere)
+	FDataStatistics Statistics;
 };
@@ -14,8 +14,9 @@ class VRSMOKEVIS_API UVolumeAsset : public UFdsDataAsset
 	GENERATED_BODY()
 
 public:
+	/** Paths to the volume textures, ordered by timestep. Written by the importer when creating the asset */
 	UPROPERTY()
-	TArray<FAssetData> VolumeTextures;
+	TArray<FSoftObjectPath> VolumeTextures;
 
 	/** The mass specific extinction coefficient */
 	UPROPERTY(EditAnywhere)
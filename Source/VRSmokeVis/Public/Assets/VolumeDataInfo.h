@@ -18,6 +18,23 @@ public:
 	/** Returns the number of voxels in this volume */
 	int64 GetTotalVoxels() const;
 
+	/** Returns the size of the volume in voxels as integers */
+	FIntVector GetVoxelDimensions() const;
+
+	int GetNumTimeSteps() const;
+
+	/** Returns the number of timesteps stacked into each volume texture, which is at least 1 */
+	int GetTimeStepsPerTexture() const;
+
+	/** Returns the number of volume textures needed to store all timesteps */
+	int GetNumTextures() const;
+
+	/** Returns the number of timesteps stacked into the given volume texture, the last one might not be full */
+	int GetNumStackedTimeSteps(const int TextureIndex) const;
+
+	/** Returns the number of bytes of the given volume texture */
+	int64 GetTextureByteSize(const int TextureIndex) const;
+
 	virtual FString ToString() const override;
 	
 	/** Name of the volume file that was loaded */
@@ -36,6 +53,11 @@ public:
 	UPROPERTY(VisibleAnywhere)
 	FVector4 Dimensions;
 
+	/** Number of timesteps stacked along the z-axis of each volume texture. 0 if the volume has been imported before
+	 * timesteps could be stacked, which equals one timestep per texture */
+	UPROPERTY(VisibleAnywhere)
+	int TimeStepsPerTexture = 0;
+
 	/** Size of a voxel in mm (w equals time in seconds)  */
 	UPROPERTY(VisibleAnywhere)
 	FVector4 Spacing;
@@ -48,6 +70,9 @@ public:
 	UPROPERTY(VisibleAnywhere)
 	FVector WorldDimensions;
 
+	/** Transmission of a cell without any density, the value empty timesteps and bricks consist of in the Statistics */
+	static constexpr uint8 EmptyTransmission = 255;
+
 	/** Lowest value possible for this type of data */
 	UPROPERTY(VisibleAnywhere)
 	float MinValue;
@@ -60,4 +85,9 @@ public:
 	* an original value of 200 */
 	UPROPERTY(VisibleAnywhere)
 	float ScaleFactor;
+
+	/** Statistics of the stored transmissions, invalid until the data has been read. Empty cells have a transmission of
+	 * EmptyTransmission */
+	UPROPERTY(VisibleAnywhere)
+	FDataStatistics Statistics;
 };
@@ -28,4 +28,17 @@ public:
 
 	UPROPERTY(BlueprintReadOnly)
 	class UUserInterfaceUserWidget* UserInterfaceUserWidget;
+
+	/** Seconds between two updates of the memory usage shown with "VRSmokeVis.ShowMemoryUsage 1" */
+	UPROPERTY(EditAnywhere)
+	float MemoryUsageUpdateInterval = 0.5f;
+
+protected:
+	/** Draws the memory used by each simulation and type in the top left corner */
+	void DrawMemoryUsage();
+
+	/** The lines drawn by DrawMemoryUsage, only updated every MemoryUsageUpdateInterval seconds */
+	TArray<FString> MemoryUsageLines;
+
+	double LastMemoryUsageUpdateTime = 0;
 };
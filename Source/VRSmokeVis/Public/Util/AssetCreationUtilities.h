@@ -15,6 +15,9 @@ class VRSMOKEVIS_API FAssetCreationUtils
 public:
 	/** Loads all Textures for an asset with the specified type */
 	static void LoadTextures(UDataInfo* DataInfo, const FString& Type);
+
+	/** Saves the package of an existing DataInfo again, e.g. after the statistics of its data have been computed */
+	static void SaveDataInfo(UDataInfo* DataInfo);
 	
 	/** Loads all Textures for a specific obst */
 	static void LoadObstTextures(UBoundaryDataInfo* DataInfo);
@@ -25,20 +28,47 @@ public:
 	/** Loads all VolumeTextures for a specific volume */
 	static void LoadVolumeTextures(UVolumeDataInfo* DataInfo);
 
+	/** Returns the name of the texture of an asset for a specific timestep, e.g. ST_<ImportName>_Data_t<TimeStep> */
+	static FString GetTextureName(const FString& TexturePrefix, const int TimeStep);
+
+	/** Fills the texture path tables of an asset with the specified type. The tables are ordered by timestep */
+	static void CreateTexturePathTables(class UFdsDataAsset* Asset, const FString& Type);
+
+	/** Writes the data of all timesteps of a slice or volume into a single sidecar file and adds the time series
+	 * describing it to the asset */
+	static void CreateTimeSeries(class UFdsDataAsset* Asset, const FString& Type);
+
 	/** Prepares the simulation asset and also loads all assets defined in the simulation */
 	static UObject* CreateSimulation(const FString& InFileName, const FString& OutDirectory);
 	
 protected:
-	/** Loads the information about an obstruction and creates the obstruction asset */
-	static void LoadAndCreateObstruction(const FString& RootPackage, const FString& FileName, const bool LazyLoad);
+	/** Saves the package containing the asset to the given file and adds the time it took to the import stats */
+	static bool SavePackage(UPackage* Package, UObject* Asset, const TCHAR* PackageFileName,
+	                        const struct FSavePackageArgs& SavePackageArgs);
+
+	/** Fills a single texture path table with the paths of all NumTimeSteps textures in the given directory */
+	static void FillTexturePaths(TArray<FSoftObjectPath>& TexturePaths, const FString& TextureDir,
+	                             const FString& TexturePrefix, const int NumTimeSteps);
+
+	/** Loads the information about an obstruction and creates the obstruction asset, whose path is added to OutPaths */
+	static void LoadAndCreateObstruction(const FString& RootPackage, const FString& FileName, const bool LazyLoad,
+	                                     TArray<FSoftObjectPath>& OutPaths);
 	
-	/** Loads the information about multiple slices read from a .yaml file and creates the slice assets */
-	static void LoadSlice(const FString& RootPackage, const FString& FileName, const bool LazyLoad);
+	/** Packs the boundary data of all faces of all obstructions of a simulation into one atlas texture per quantity and
+	 * timestep. The position of each face inside the atlas is stored in the obstruction assets */
+	static void CreateObstAtlas(class USimulationAsset* SimAsset, const FString& RootPackage, const FString& SimName);
+
+	/** Loads the information about multiple slices read from a .yaml file and creates the slice assets, whose paths are
+	 * added to OutPaths */
+	static void LoadSlice(const FString& RootPackage, const FString& FileName, const bool LazyLoad,
+	                      TArray<FSoftObjectPath>& OutPaths);
 	/** Creates a single slice containing (meta-)data for one mesh (basically a subslice) */
 	static class USliceAsset* CreateSlice(USliceDataInfo* DataInfo, const FString& FileName, UObject* Package,
 										   const FString& MeshName, const bool LazyLoad);
-	/** Loads the information about multiple volumes read from a .yaml file and creates the volume assets */
-	static void LoadVolumes(const FString& RootPackage, const FString& FileName, const bool LazyLoad);
+	/** Loads the information about multiple volumes read from a .yaml file and creates the volume assets, whose paths
+	 * are added to OutPaths */
+	static void LoadVolumes(const FString& RootPackage, const FString& FileName, const bool LazyLoad,
+	                        TArray<FSoftObjectPath>& OutPaths);
 	/** Creates a single volume containing smoke (meta-)data for one mesh */
 	static class UVolumeAsset* CreateVolume(UVolumeDataInfo* DataInfo, const FString& FileName, UObject* Package,
 											 const FString& MeshName, const bool LazyLoad);
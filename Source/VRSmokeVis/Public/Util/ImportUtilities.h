@@ -1,8 +1,34 @@
 ﻿#pragma once
 
+#include "Util/StagingBufferPool.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogImportUtils, All, All);
 
+/**
+ * Time spent in the different phases of an import, accumulated over all assets since the last reset. Only updated by
+ * the importer, which runs on the game thread.
+ */
+struct FImportStats
+{
+	/** Time spent parsing the .yaml files of the simulation, obstructions, slices and volumes */
+	double ParseSeconds = 0;
+
+	/** Time spent reading .dat files from disk */
+	double ReadSeconds = 0;
+
+	/** Time spent converting the raw data, e.g. densities to transmission */
+	double ConvertSeconds = 0;
+
+	/** Time spent creating texture assets from the converted data */
+	double TextureCreateSeconds = 0;
+
+	/** Time spent saving packages and time series to disk */
+	double SaveSeconds = 0;
+
+	/** Number of bytes read from .dat files */
+	int64 BytesRead = 0;
+};
+
 /**
  * Utility functions for loading (meta-)data from the file system and preprocessing that data.
  */
@@ -19,25 +45,48 @@ public:
 	 * only valid characters */
 	static void SplitPath(const FString& FullPath, FString& OutFilePath, FString& OutFilename);
 
-	/** Loads a DAT file into a newly allocated uint8* array. Loads the given number of bytes. Don't forget to delete[]
-	 * after storing the data somewhere */
-	static uint8* LoadDatFileIntoArray(const FString FileName, const int64 BytesToLoad);
+	/** Loads the given number of bytes of a DAT file, starting at Offset, into a buffer from the staging buffer pool.
+	 * The returned buffer is invalid if the file could not be read */
+	static FStagingBuffer LoadDatFileIntoArray(const FString FileName, const int64 BytesToLoad, const int64 Offset = 0);
 
 	/** Converts an array of densities to the resulting transmission */
 	static void DensityToTransmission(const float ExtinctionCoefficient, const class UVolumeDataInfo* DataInfo, uint8* Array);
 
-	/** Normalizes an array to the full range of 0-255 (1 Byte) */
-	static void NormalizeArray(const class UVolumeDataInfo* DataInfo, uint8* Array);
+	/** Converts the given number of densities to the resulting transmission, independent of any DataInfo */
+	static void DensityToTransmission(const float ExtinctionCoefficient, uint8* Array, const int64 NumBytes);
 
-	/** Loads the raw data specified in the DataInfo and converts it so that it is usable with our raymarching materials */
-	static uint8* LoadAndConvertVolumeData(const float ExtinctionCoefficient, const FString& FilePath,
-	                                       const class UVolumeDataInfo* DataInfo);
+	/** The transmission (0-255) of a single density, as written by DensityToTransmission */
+	static uint8 GetTransmission(const float ExtinctionCoefficient, const uint8 Density);
 
-	/** Loads the raw data specified in the DataInfo */
-	static uint8* LoadSliceData(const FString& FilePath, const class USliceDataInfo* DataInfo);
+	/** Normalizes an array to the full range of 0-255 (1 Byte) */
+	static void NormalizeArray(const class UVolumeDataInfo* DataInfo, uint8* Array);
 
-	/** Loads the raw data specified in the DataInfo */
-	static uint8* LoadObstData(const FString& FilePath, const class UBoundaryDataInfo* DataInfo);
+	/** Normalizes the given number of values between MinValue and MaxValue to the full range of 0-255 */
+	static void NormalizeArray(const float MinValue, const float MaxValue, uint8* Array, const int64 NumBytes);
+
+	/** Computes the statistics of NumTimeSteps consecutive timesteps of the given size in a single parallel pass. If a
+	 * Conversion table is given, each value is replaced by its entry in the same pass and the statistics describe the
+	 * converted values, i.e. the values that are stored */
+	static void ComputeStatistics(uint8* Data, const FIntVector& Dimensions, const int NumTimeSteps,
+	                              struct FDataStatistics& OutStatistics, const uint8* Conversion = nullptr);
+
+	/** Loads the raw data specified in the DataInfo one texture (see UVolumeDataInfo::GetNumTextures) at a time and
+	 * converts it so that it is usable with our raymarching materials. Each converted texture is passed to
+	 * OnTextureLoaded before the next one is read, so only a single texture is held in memory, no matter how large the
+	 * whole file is. OnTextureLoaded returns false to stop loading. The statistics of the transmissions are computed
+	 * while converting them, if OutStatistics is given. Returns whether all textures have been loaded */
+	static bool LoadAndConvertVolumeData(
+		const float ExtinctionCoefficient, const FString& FilePath, const class UVolumeDataInfo* DataInfo,
+		TFunctionRef<bool(int TextureIndex, uint8* Data, int64 NumBytes)> OnTextureLoaded,
+		struct FDataStatistics* OutStatistics = nullptr);
+
+	/** Loads the raw data specified in the DataInfo and computes its statistics, if OutStatistics is given */
+	static FStagingBuffer LoadSliceData(const FString& FilePath, const class USliceDataInfo* DataInfo,
+	                                    struct FDataStatistics* OutStatistics = nullptr);
+
+	/** Loads the raw data specified in the DataInfo and computes the statistics of all faces, if OutStatistics is given */
+	static FStagingBuffer LoadObstData(const FString& FilePath, const class UBoundaryDataInfo* DataInfo,
+	                                   struct FDataStatistics* OutStatistics = nullptr);
 
 	/** Get info about volumes before loading them */
 	static void ParseVolumeDataInfoFromFile(const FString& FileName, UPARAM(ref) TMap<FString, class UVolumeDataInfo*>& DataInfos);
@@ -56,4 +105,9 @@ public:
 	
 	/** If this function cannot find or create the directory, returns false */
 	static bool VerifyOrCreateDirectory(const FString& TestDir);
+
+	/** Returns the timings of all imports since the last call to ResetImportStats */
+	static FImportStats& GetImportStats();
+
+	static void ResetImportStats();
 };
@@ -0,0 +1,151 @@
+// Collects statistics about the streaming of textures while a simulation is played back in benchmark mode
+
+#pragma once
+
+#include "PlaybackBenchmark.generated.h"
+
+
+DECLARE_LOG_CATEGORY_EXTERN(LogPlaybackBenchmark, Log, All);
+
+
+/**
+ * What to play back during a playback benchmark and how.
+ */
+USTRUCT(BlueprintType)
+struct VRSMOKEVIS_API FPlaybackBenchmarkSettings
+{
+	GENERATED_BODY()
+
+	/** Time between two timesteps in seconds. Keeps the update rate of the simulation if set to 0 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float UpdateRate = 0;
+
+	/** Only obstructions, slices and volumes whose name contains one of these are activated. Empty to activate all */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> ActorNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bObstructions = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSlices = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bVolumes = true;
+
+	/** Number of times the playback jumps, alternating between fast-forwarding and rewinding */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int NumSeekBursts = 2;
+
+	/** Number of timesteps skipped by each jump */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int SeekBurstSteps = 20;
+
+	/** The .json file the results are written to, defaults to Saved/PlaybackBenchmark/PlaybackBenchmark.json */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString ReportFile;
+
+	/** Quits the game once the benchmark has finished */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bQuitWhenFinished = false;
+
+	/** Reads the settings from parameters like -UpdateRate=0.05 -Actors=Slice1,Smoke -NoObsts -NoSlices -NoVolumes
+	 * -SeekBursts=2 -SeekSteps=20 -Report=<File.json> -Quit, missing values keep their default */
+	static FPlaybackBenchmarkSettings FromCommandLine(const TCHAR* Params);
+};
+
+/**
+ * Results of a playback benchmark. Latencies and times are given in milliseconds.
+ */
+USTRUCT(BlueprintType)
+struct VRSMOKEVIS_API FPlaybackBenchmarkResults
+{
+	GENERATED_BODY()
+
+	/** Number of timesteps that have been shown, summed up over all types */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int NumTimeSteps = 0;
+
+	/** Number of timesteps for which at least one texture was not loaded yet when it was shown */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int NumStalledTimeSteps = 0;
+
+	/** Number of textures that have been requested to be streamed */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 NumTextureRequests = 0;
+
+	/** Share of the requested textures that were still loaded and didn't have to be streamed again */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float CacheHitRate = 0;
+
+	/** Time from requesting the textures of a timestep until all of them have been loaded */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float MeanStreamLatency = 0;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float P95StreamLatency = 0;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float MaxStreamLatency = 0;
+
+	/** Game thread time spent in ASimulation::NextTimeStep, including LoadUnloadTimeStep */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float MeanNextTimeStepTime = 0;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float MaxNextTimeStepTime = 0;
+
+	/** Game thread time spent in ASimulation::LoadUnloadTimeStep */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float MeanLoadUnloadTimeStepTime = 0;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float MaxLoadUnloadTimeStepTime = 0;
+
+	/** Highest amount of texture memory in bytes used at any time during the benchmark */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 PeakTextureMemory = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float TotalSeconds = 0;
+};
+
+/**
+ * Records the samples of a single playback benchmark, which is driven by the simulation.
+ */
+class VRSMOKEVIS_API FPlaybackBenchmark
+{
+public:
+	explicit FPlaybackBenchmark(const FPlaybackBenchmarkSettings& InSettings);
+
+	/** Records that a timestep has been shown and whether any of its textures was missing */
+	void AddTimeStep(const bool bStalled);
+
+	/** Records a request of textures to be streamed, of which NumHits were still loaded */
+	void AddTextureRequest(const int NumTextures, const int NumHits);
+
+	void AddStreamLatency(const double Seconds);
+
+	void AddNextTimeStepTime(const double Seconds);
+
+	void AddLoadUnloadTimeStepTime(const double Seconds);
+
+	/** Updates the peak texture memory with the texture memory currently used */
+	void SampleTextureMemory();
+
+	/** Computes the results from all samples recorded so far */
+	FPlaybackBenchmarkResults GetResults() const;
+
+	/** Writes the results as .json into the report file of the settings */
+	bool WriteReport(const FPlaybackBenchmarkResults& Results) const;
+
+	const FPlaybackBenchmarkSettings Settings;
+
+protected:
+	double StartTime;
+
+	FPlaybackBenchmarkResults Counters;
+
+	int64 NumTextureHits = 0;
+
+	/** All samples in milliseconds */
+	TArray<float> StreamLatencies;
+	TArray<float> NextTimeStepTimes;
+	TArray<float> LoadUnloadTimeStepTimes;
+};
@@ -0,0 +1,81 @@
+// Index math of the window of textures that is kept loaded around the current timestep during playback
+
+#pragma once
+
+
+/**
+ * Which textures are loaded and unloaded while playing back a simulation. Only depends on its parameters, so the
+ * streaming can be reasoned about (and tested) without a world or any assets.
+ */
+struct VRSMOKEVIS_API FPlaybackWindow
+{
+	/** Number of timesteps the textures are requested ahead of the current timestep */
+	static constexpr int PrefetchDistance = 9;
+
+	/** Number of timesteps behind the current timestep whose textures are unloaded. The previous timestep is kept, as
+	 * it might still be referenced for time interpolation */
+	static constexpr int UnloadDistance = 2;
+
+	/** Maximum number of timesteps jumped forwards at once, far beyond the end of any simulation but small enough to
+	 * not overflow the resulting timestep */
+	static constexpr int MaxSeekAmount = 1 << 24;
+
+	/** The timestep whose textures are requested when the given timestep is shown, wrapping around at the end */
+	static FORCEINLINE int GetPrefetchTimeStep(const int TimeStep, const int NumTimeSteps)
+	{
+		return (TimeStep + PrefetchDistance) % NumTimeSteps;
+	}
+
+	/** The timestep whose textures are unloaded when the given timestep is shown, wrapping around at the beginning */
+	static FORCEINLINE int GetUnloadTimeStep(const int TimeStep, const int NumTimeSteps)
+	{
+		return (TimeStep + NumTimeSteps - UnloadDistance) % NumTimeSteps;
+	}
+
+	/** The texture containing the given timestep, textures may contain multiple timesteps as layers of an array */
+	static FORCEINLINE int GetTextureIndex(const int TimeStep, const int TimeStepsPerTexture)
+	{
+		return TimeStep / TimeStepsPerTexture;
+	}
+
+	/** Texture arrays are only requested once, for their first timestep */
+	static FORCEINLINE bool ShouldRequestTexture(const int PrefetchTimeStep, const int TimeStepsPerTexture)
+	{
+		return PrefetchTimeStep % TimeStepsPerTexture == 0;
+	}
+
+	/** Texture arrays are only unloaded once their last timestep has passed. The last texture might not be full */
+	static FORCEINLINE bool ShouldUnloadTexture(const int UnloadTimeStep, const int TimeStepsPerTexture,
+	                                            const int NumTimeSteps)
+	{
+		return (UnloadTimeStep + 1) % TimeStepsPerTexture == 0 || UnloadTimeStep == NumTimeSteps - 1;
+	}
+
+	/** Number of timesteps that are loaded synchronously when an actor is activated, so they are available at once */
+	static FORCEINLINE int GetNumInitialTimeSteps(const int NumTimeSteps)
+	{
+		return FMath::Min(NumTimeSteps, PrefetchDistance + 1);
+	}
+
+	/** The timestep to continue from after jumping Amount timesteps forwards, NextTimeStep then advances to the
+	 * target and starts over if it is past the end. Amount is clamped, so any float can be passed */
+	static FORCEINLINE int GetFastForwardTimeStep(const int TimeStep, const float Amount)
+	{
+		return TimeStep + FMath::TruncToInt(FMath::Clamp(Amount, 0.f, static_cast<float>(MaxSeekAmount))) - 1;
+	}
+
+	/** The timestep to continue from after jumping Amount timesteps backwards, stops at the first timestep. Amount is
+	 * clamped, so any float can be passed */
+	static FORCEINLINE int GetRewindTimeStep(const int TimeStep, const float Amount)
+	{
+		return TimeStep - FMath::TruncToInt(FMath::Clamp(Amount, 0.f, static_cast<float>(TimeStep))) - 1;
+	}
+
+	/** Advances the timestep of the given type by one. Once it reaches the end, all types start over to stay in sync:
+	 * the given type continues with its first timestep, all others with -1, as their timers are restarted to fire at
+	 * once. SkipTimeStep is called for each timestep of the other types that is skipped by starting over. Returns
+	 * whether the types have started over */
+	static bool AdvanceTimeStep(const FString& Type, TMap<FString, int>& TimeSteps,
+	                            const TMap<FString, int>& NumTimeSteps,
+	                            TFunctionRef<void(const FString& SkippedType, int SkippedTimeStep)> SkipTimeStep);
+};
@@ -0,0 +1,113 @@
+// Contains a pool of staging buffers used when loading data from disk and uploading it to textures
+
+#pragma once
+
+
+DECLARE_LOG_CATEGORY_EXTERN(LogStagingBufferPool, Log, All);
+
+
+/**
+ * Statistics of the staging buffer pool.
+ */
+struct FStagingBufferPoolStats
+{
+	/** Number of buffers that could be taken from the pool */
+	int64 NumHits = 0;
+
+	/** Number of buffers that had to be allocated */
+	int64 NumMisses = 0;
+
+	/** Number of bytes currently kept in the pool for later use */
+	int64 PooledBytes = 0;
+
+	/** Number of bytes currently handed out to users of the pool */
+	int64 UsedBytes = 0;
+};
+
+/**
+ * Thread-safe pool of large, aligned buffers. The buffers are grouped into buckets of power of two sizes, or of finer
+ * size classes for large buffers, so loading and uploading timesteps of the same size repeatedly reuses the same memory
+ * instead of allocating it each time.
+ */
+class VRSMOKEVIS_API FStagingBufferPool
+{
+public:
+	/** Alignment of all buffers, suitable for SIMD and DMA transfers */
+	static constexpr int64 Alignment = 4096;
+
+	/** Size of the smallest bucket */
+	static constexpr int64 MinBucketSize = 64 * 1024;
+
+	/** Buffers larger than this are not rounded up to a power of two, but to one of SizeClassesPerPowerOfTwo sizes
+	 * between two powers of two, so they waste at most an eighth of their size instead of almost half of it */
+	static constexpr int64 MaxPowerOfTwoBucketSize = 2 * 1024 * 1024;
+
+	static constexpr int64 SizeClassesPerPowerOfTwo = 8;
+
+	/** Buffers larger than this are freed when released instead of being kept in the pool */
+	static constexpr int64 MaxPooledBufferSize = 1024 * 1024 * 1024;
+
+	/** Maximum number of unused buffers kept per bucket */
+	static constexpr int MaxPooledBuffersPerBucket = 4;
+
+	/** Maximum number of bytes kept in unused buffers over all buckets, further released buffers are freed */
+	static constexpr int64 MaxPooledBytes = 2ll * 1024 * 1024 * 1024;
+
+	static FStagingBufferPool& Get();
+
+	~FStagingBufferPool();
+
+	/** Returns a buffer of at least the given size, either from the pool or newly allocated */
+	uint8* Acquire(const int64 Size);
+
+	/** Returns a buffer acquired from this pool, so it can be reused */
+	void Release(uint8* Buffer);
+
+	/** Frees all buffers that are currently unused */
+	void Trim();
+
+	FStagingBufferPoolStats GetStats() const;
+
+protected:
+	static int64 GetBucketSize(const int64 Size);
+
+	mutable FCriticalSection CriticalSection;
+
+	/** Unused buffers for each bucket size */
+	TMap<int64, TArray<uint8*>> FreeBuffers;
+
+	/** Bucket sizes of all buffers that are currently in use */
+	TMap<uint8*, int64> UsedBuffers;
+
+	FStagingBufferPoolStats Stats;
+};
+
+/**
+ * Owns a buffer from the staging buffer pool and returns it to the pool when destroyed.
+ */
+class VRSMOKEVIS_API FStagingBuffer
+{
+public:
+	FStagingBuffer() = default;
+	explicit FStagingBuffer(const int64 InSize);
+	~FStagingBuffer();
+
+	FStagingBuffer(FStagingBuffer&& Other) noexcept;
+	FStagingBuffer& operator=(FStagingBuffer&& Other) noexcept;
+	FStagingBuffer(const FStagingBuffer&) = delete;
+	FStagingBuffer& operator=(const FStagingBuffer&) = delete;
+
+	uint8* GetData() const { return Data; }
+
+	/** The number of bytes requested, the underlying buffer may be larger */
+	int64 Num() const { return Size; }
+
+	bool IsValid() const { return Data != nullptr; }
+
+	/** Returns the buffer to the pool */
+	void Reset();
+
+private:
+	uint8* Data = nullptr;
+	int64 Size = 0;
+};
@@ -0,0 +1,79 @@
+// Generates simulations in the intermediate file format without running FDS, e.g. for benchmarks
+
+#pragma once
+
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSyntheticData, Log, All);
+
+
+/**
+ * How the data of a synthetic simulation is distributed inside of its domain.
+ */
+enum class ESyntheticDataPattern : uint8
+{
+	/** A single plume rising from the center of the domain, most of the domain stays empty */
+	Plume,
+	/** A smoke layer descending from the ceiling */
+	Layers,
+	/** Random values everywhere, the worst case for any kind of sparsity */
+	Noise
+};
+
+/**
+ * Size and content of a synthetic simulation.
+ */
+struct VRSMOKEVIS_API FSyntheticDataSettings
+{
+	/** Number of meshes, placed next to each other along the x-axis. Each slice and volume has data for every mesh */
+	int NumMeshes = 1;
+
+	/** Number of cells of each mesh */
+	FIntVector MeshResolution = FIntVector(64, 64, 32);
+
+	int NumTimeSteps = 100;
+
+	int NumObstructions = 8;
+
+	int NumSlices = 2;
+
+	int NumVolumes = 1;
+
+	ESyntheticDataPattern Pattern = ESyntheticDataPattern::Plume;
+
+	/** Generating data with the same settings and seed always results in the same files */
+	int Seed = 0;
+
+	/** Reads the settings from parameters like -Meshes=4 -Resolution=64x64x32 -TimeSteps=100 -Obstructions=8 -Slices=2
+	 * -Volumes=1 -Pattern=Plume|Layers|Noise -Seed=0 -Scale=10. Scale multiplies the number of meshes */
+	static FSyntheticDataSettings FromCommandLine(const TCHAR* Params);
+
+	FString ToString() const;
+};
+
+/**
+ * Writes the .yaml and .dat files of synthetic obstructions, slices and volumes just like the preprocessor would.
+ */
+class VRSMOKEVIS_API FSyntheticDataGenerator
+{
+public:
+	/** Writes a complete simulation into the given directory. Returns the path of the simulation file
+	 * ([chid]-smv.yaml), which can be imported like any other, or an empty string if a file could not be written */
+	static FString GenerateSimulation(const FSyntheticDataSettings& Settings, const FString& OutputDir);
+
+protected:
+	/** Writes an obstruction with all six faces and returns the name of its .yaml file */
+	static FString WriteObstruction(const FSyntheticDataSettings& Settings, const FString& OutputDir, const int Index);
+
+	/** Writes a horizontal slice through all meshes and returns the name of its .yaml file */
+	static FString WriteSlice(const FSyntheticDataSettings& Settings, const FString& OutputDir, const int Index);
+
+	/** Writes a volume covering all meshes and returns the name of its .yaml file */
+	static FString WriteVolume(const FSyntheticDataSettings& Settings, const FString& OutputDir, const int Index);
+
+	/** Writes all timesteps into a .dat file, each of them filled by FillTimeStep */
+	static bool WriteDataFile(const FString& FilePath, const int64 TimeStepSize, const int NumTimeSteps,
+	                          TFunctionRef<void(int TimeStep, uint8* Data)> FillTimeStep);
+
+	/** Returns the value of the data at a position and time, both normalized to the domain, between 0 and 1 */
+	static float SampleField(const FSyntheticDataSettings& Settings, const FVector& Position, const float Time);
+};
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include "Engine/Texture2DArray.h"
 #include "Engine/VolumeTexture.h"
+#include "Util/StagingBufferPool.h"
 
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTextureUtils, All, All);
@@ -18,7 +20,8 @@ public:
 	static void SetTextureDetails(UTexture* OutTexture, const FVector4 Dimensions);
 
 	/** Creates the texture's 0th mip from the bulkdata provided.*/
-	static void CreateTextureMip(UTexture* OutTexture, const FVector4 Dimensions, uint8* BulkData, const int DataSize);
+	static void CreateTextureMip(UTexture* OutTexture, const FVector4 Dimensions, uint8* BulkData,
+	                             const int64 DataSize);
 
 	
 #if WITH_EDITOR
@@ -30,15 +33,35 @@ public:
 	/** Creates a Texture asset with the given name, pixel format and dimensions and fills it with the bulk data
 	* provided */
 	static UTexture2D* CreateTextureAsset(const FString AssetName, const FVector4 Dimensions, UObject* OutPackage,
-	                                      uint8* BulkData, const int DataSize);
+	                                      uint8* BulkData, const int64 DataSize);
 
 	/** Creates a Texture asset for a slice with the given name, pixel format and dimensions and fills it with the bulk
 	 * data provided */
 	static UTexture2D* CreateSliceTextureAsset(const FString AssetName, const FVector4 Dimensions, UObject* OutPackage,
-	                                           uint8* BulkData, const int DataSize);
+	                                           uint8* BulkData, const int64 DataSize);
+
+	/** Creates a Texture2DArray asset for a slice in which each layer contains the data of a single timestep. The w
+	 * component of the dimensions equals the number of layers */
+	static UTexture2DArray* CreateSliceTextureArrayAsset(const FString AssetName, const FVector4 Dimensions,
+	                                                     UObject* OutPackage, uint8* BulkData,
+	                                                     const int64 DataSize);
 
 	/** Creates a VolumeTexture asset with the given name, pixel format and dimensions and fills it with the bulk data
 	* provided */
 	static UVolumeTexture* CreateVolumeAsset(const FString AssetName, const FVector4 Dimensions, UObject* OutPackage,
-	                                         uint8* BulkData, const int DataSize);
+	                                         uint8* BulkData, const int64 DataSize);
+
+	/** Packs rectangles of the given sizes into rows of a single atlas. Returns the size of the atlas and fills in the
+	 * offset of each rectangle inside of it */
+	static FIntPoint PackAtlas(const TArray<FIntPoint>& Sizes, TArray<FIntPoint>& OutOffsets);
+
+	/** Swaps the dimensions of a slice so the first two are the ones describing the texture dimensions */
+	static FVector4 GetSliceTextureDimensions(FVector4 Dimensions);
+
+	/** Creates an empty transient texture whose data is updated at runtime. A 2D texture is created if the z dimension
+	 * equals 1, a volume texture otherwise */
+	static UTexture* CreateTransientTexture(const FIntVector Dimensions);
+
+	/** Replaces the whole content of a texture created by CreateTransientTexture on the rendering thread */
+	static void UpdateTextureData(UTexture* Texture, const FIntVector Dimensions, FStagingBuffer&& Data);
 };
@@ -13,9 +13,18 @@ class VRSMOKEVIS_API UVRSSConfig : public UObject
 	GENERATED_BODY()
 
 public:
+	/** Returns the colormap used for the quantity, or any colormap if none has been configured for it */
 	UFUNCTION(BlueprintCallable)
 	UTexture2D* GetColorMap(const FString Quantity);
 
+	/** Returns the colormap with the given name (without the "CM_" prefix) or nullptr if it doesn't exist */
+	UFUNCTION(BlueprintCallable)
+	UTexture2D* GetColorMapByName(const FString& Name);
+
+	/** Returns the names of all colormaps in the ColorMapsPath, sorted alphabetically */
+	UFUNCTION(BlueprintCallable)
+	TArray<FString> GetColorMapNames();
+
 	UFUNCTION(BlueprintCallable)
 	float GetSliceCutOffValue(const FString Quantity) const;
 
@@ -31,6 +40,18 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void SetActiveObstQuantity(const FString& NewQuantity);
 
+	UFUNCTION(BlueprintCallable)
+	bool ShouldPackObstAtlas() const;
+
+	UFUNCTION(BlueprintCallable)
+	int GetSliceTimeStepsPerTexture() const;
+
+	UFUNCTION(BlueprintCallable)
+	int GetVolumeTimeStepsPerTexture() const;
+
+	UFUNCTION(BlueprintCallable)
+	bool ShouldWriteTimeSeries() const;
+
 protected:
 	/** The values below which a specific quantity should become fully transparent (slices only) */
 	UPROPERTY(Config)
@@ -51,5 +72,44 @@ protected:
 	UPROPERTY(Config)
 	FString ActiveObstQuantity;
 
+	/** Whether the boundary data of all obstruction faces should be packed into one atlas texture per quantity and
+	 * timestep when importing a simulation */
+	UPROPERTY(Config)
+	bool bPackObstAtlas = false;
+
+	/** Number of consecutive timesteps of a slice that are packed into the layers of a single texture array when
+	 * importing a simulation. 1 creates one 2D texture per timestep */
+	UPROPERTY(Config)
+	int SliceTimeStepsPerTexture = 1;
+
+	/** Number of consecutive timesteps of a volume that are stacked along the z-axis of a single volume texture when
+	 * importing a simulation. 1 creates one volume texture per timestep */
+	UPROPERTY(Config)
+	int VolumeTimeStepsPerTexture = 1;
+
+	/** Whether slices and volumes should be imported as time series, which store the data of all timesteps in a single
+	 * file that is streamed at runtime instead of creating a texture asset per timestep */
+	UPROPERTY(Config)
+	bool bWriteTimeSeries = false;
+
 	FStreamableManager StreamableManager;
+
+private:
+	/** Finds all colormap textures in the ColorMapsPath. Only scans the asset registry on the first call */
+	void DiscoverColorMaps();
+
+	/** Returns the name of the colormap used for the quantity */
+	const FString* GetColorMapName(const FString& Quantity);
+
+	/** Names of all colormaps, sorted alphabetically */
+	TArray<FString> ColorMapNames;
+
+	/** Paths of the colormap textures by the name of the colormap */
+	TMap<FString, FSoftObjectPath> ColorMapPaths;
+
+	bool bColorMapsDiscovered = false;
+
+	/** The colormaps that have already been loaded by their name, they are kept loaded as they are tiny */
+	UPROPERTY(Transient)
+	TMap<FString, UTexture2D*> LoadedColorMaps;
 };
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "Actor/Simulation.h"
 #include "VRSSGameInstanceSubsystem.generated.h"
 
 /**
@@ -27,6 +28,19 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void ChangeObstQuantity(FString& NewQuantity);
 
+	/** Called by the simulations whenever an actor showing the given quantity has been activated or deactivated, so the
+	 * active quantities don't have to be collected from all simulations on each change */
+	void AddActiveQuantity(const FString& Quantity);
+	void RemoveActiveQuantity(const FString& Quantity);
+
+	/** Returns the memory used by each of the registered simulations */
+	UFUNCTION(BlueprintCallable)
+	TArray<FSimulationMemoryUsage> GetMemoryUsage() const;
+
+	/** Logs the memory used by each simulation, split by type and, if bPerActor is set, by actor. Can be called via the
+	 * console command "VRSmokeVis.MemoryUsage [-Actors]" */
+	void LogMemoryUsage(const bool bPerActor) const;
+
 protected:
 public:
 	/** An instance of the configuration for the project which simply uses its default values set in the editor. */
@@ -36,4 +50,13 @@ public:
 protected:
 	UPROPERTY()
 	TArray<class ASimulation*> Simulations;
+
+	/** Value range of each quantity over all registered simulations, only extended by the range of each newly
+	 * registered simulation */
+	TMap<FString, float> QuantityMins;
+	TMap<FString, float> QuantityMaxs;
+
+	/** Number of active actors per quantity over all simulations. Obstructions are counted once per simulation, as they
+	 * all show the same quantity. Quantities are removed as soon as no actor shows them anymore */
+	TMap<FString, int> ActiveQuantityCounts;
 };
@@ -0,0 +1,60 @@
+// Stats and trace events of the hot paths of the import and the playback, visible via "stat VRSmokeVis" and in
+// Unreal Insights when tracing with -trace=cpu,VRSmokeVis
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+
+UE_TRACE_CHANNEL_EXTERN(VRSmokeVisChannel, VRSMOKEVIS_API);
+
+DECLARE_STATS_GROUP(TEXT("VRSmokeVis"), STATGROUP_VRSmokeVis, STATCAT_Advanced);
+
+// Playback
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RegisterTextureLoad"), STAT_VRSS_RegisterTextureLoad, STATGROUP_VRSmokeVis,
+                          VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("NextTimeStep"), STAT_VRSS_NextTimeStep, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("LoadUnloadTimeStep"), STAT_VRSS_LoadUnloadTimeStep, STATGROUP_VRSmokeVis,
+                          VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Obst"), STAT_VRSS_UpdateObst, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Slice"), STAT_VRSS_UpdateSlice, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Volume"), STAT_VRSS_UpdateVolume, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Read TimeSeries"), STAT_VRSS_ReadTimeSeries, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Activate"), STAT_VRSS_Activate, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Deactivate"), STAT_VRSS_Deactivate, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+
+// Import
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse"), STAT_VRSS_Parse, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Read Data"), STAT_VRSS_ReadData, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Convert"), STAT_VRSS_Convert, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Create Texture"), STAT_VRSS_CreateTexture, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Save Package"), STAT_VRSS_SavePackage, STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+
+// Counters
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Textures Resident"), STAT_VRSS_TexturesResident, STATGROUP_VRSmokeVis,
+                                      VRSMOKEVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Texture Requests"), STAT_VRSS_TextureRequests, STATGROUP_VRSmokeVis,
+                                  VRSMOKEVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Texture Misses"), STAT_VRSS_TextureMisses, STATGROUP_VRSmokeVis,
+                                  VRSMOKEVIS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Streamed MB/s"), STAT_VRSS_StreamedMegabytesPerSecond,
+                                      STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Obst Geometry Instances"), STAT_VRSS_ObstGeometryInstances,
+                                      STATGROUP_VRSmokeVis, VRSMOKEVIS_API);
+
+/** Counts the cycles of the current scope for "stat VRSmokeVis" and emits a trace event on the VRSmokeVis channel */
+#define VRSS_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, VRSmokeVisChannel)
+
+
+/**
+ * Counters that can't be derived from a single scope.
+ */
+struct VRSMOKEVIS_API FVRSSStats
+{
+	/** Adds bytes that have been streamed from disk. The streaming rate is updated from these at most once per second,
+	 * so it keeps its last value while nothing is streamed. Game thread only */
+	static void AddStreamedBytes(const int64 NumBytes);
+};
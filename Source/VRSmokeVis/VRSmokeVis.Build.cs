@@ -46,6 +46,8 @@ public class VRSmokeVis : ModuleRules
 				"Slate",
                 "SlateCore",
                 "UMG",
+                "Json",
+                "JsonUtilities",
 				// ... add private dependencies that you statically link with here ...	
 			}
             );
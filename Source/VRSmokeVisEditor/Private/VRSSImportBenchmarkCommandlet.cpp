@@ -0,0 +1,155 @@
+#include "VRSSImportBenchmarkCommandlet.h"
+
+#include "Assets/FdsDataAsset.h"
+#include "Assets/SimulationAsset.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+#include "Util/AssetCreationUtilities.h"
+#include "Util/ImportUtilities.h"
+#include "Util/StagingBufferPool.h"
+#include "Util/SyntheticDataGenerator.h"
+
+DEFINE_LOG_CATEGORY(LogImportBenchmark)
+
+
+UVRSSImportBenchmarkCommandlet::UVRSSImportBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer) :
+	Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UVRSSImportBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString InputFile;
+	if (FParse::Param(*Params, TEXT("Synthetic")))
+	{
+		const FString SyntheticDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ImportBenchmark"), TEXT("Synthetic"));
+		IFileManager::Get().DeleteDirectory(*SyntheticDir, false, true);
+		InputFile = FSyntheticDataGenerator::GenerateSimulation(FSyntheticDataSettings::FromCommandLine(*Params),
+		                                                        SyntheticDir);
+		if (InputFile.IsEmpty())
+		{
+			UE_LOG(LogImportBenchmark, Error, TEXT("Could not generate a synthetic simulation in %s"), *SyntheticDir);
+			return 1;
+		}
+	}
+	else if (!FParse::Value(*Params, TEXT("Input="), InputFile))
+	{
+		UE_LOG(LogImportBenchmark, Error,
+		       TEXT("Usage: -run=VRSSImportBenchmark -Input=<File.smv|File.yaml>|-Synthetic "
+			       "[-Output=/Game/ImportBenchmark] [-Report=<File.json|File.csv>] [-CreateTextures]"));
+		return 1;
+	}
+	FString OutputDirectory = TEXT("/Game/ImportBenchmark");
+	FParse::Value(*Params, TEXT("Output="), OutputDirectory);
+	if (!OutputDirectory.StartsWith(TEXT("/Game/")) || OutputDirectory.Len() <= 6)
+	{
+		UE_LOG(LogImportBenchmark, Error, TEXT("The output directory has to be a subdirectory of /Game/"));
+		return 1;
+	}
+	FString ReportFile = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ImportBenchmark"), TEXT("ImportBenchmark.json"));
+	FParse::Value(*Params, TEXT("Report="), ReportFile);
+
+	// An unchanged simulation would not be imported again but loaded from the previous run, so always start from scratch.
+	// Chop these 6 characters: "/Game/"
+	const FString OutputDirectoryOnDisk = FPaths::ConvertRelativePathToFull(
+		FPaths::Combine(FPaths::ProjectContentDir(), OutputDirectory.RightChop(6)));
+	IFileManager::Get().DeleteDirectory(*OutputDirectoryOnDisk, false, true);
+
+	FImportUtils::ResetImportStats();
+	const double StartTime = FPlatformTime::Seconds();
+	const USimulationAsset* SimAsset = Cast<USimulationAsset>(
+		FAssetCreationUtils::CreateSimulation(InputFile, OutputDirectory));
+	if (!SimAsset)
+	{
+		UE_LOG(LogImportBenchmark, Error, TEXT("Could not import simulation %s"), *InputFile);
+		return 1;
+	}
+	if (FParse::Param(*Params, TEXT("CreateTextures"))) CreateTextures(SimAsset);
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+	const FImportStats& ImportStats = FImportUtils::GetImportStats();
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	const FStagingBufferPoolStats PoolStats = FStagingBufferPool::Get().GetStats();
+	const TArray<TPair<FString, double>> Metrics = {
+		{TEXT("TotalSeconds"), TotalSeconds},
+		{TEXT("ParseSeconds"), ImportStats.ParseSeconds},
+		{TEXT("ReadSeconds"), ImportStats.ReadSeconds},
+		{TEXT("ConvertSeconds"), ImportStats.ConvertSeconds},
+		{TEXT("TextureCreateSeconds"), ImportStats.TextureCreateSeconds},
+		{TEXT("SaveSeconds"), ImportStats.SaveSeconds},
+		{TEXT("BytesRead"), static_cast<double>(ImportStats.BytesRead)},
+		{TEXT("NumObstructions"), SimAsset->Obstructions.Num()},
+		{TEXT("NumSlices"), SimAsset->Slices.Num()},
+		{TEXT("NumVolumes"), SimAsset->Volumes.Num()},
+		{TEXT("StagingBufferMisses"), static_cast<double>(PoolStats.NumMisses)},
+		{TEXT("PeakUsedPhysical"), static_cast<double>(MemoryStats.PeakUsedPhysical)},
+		{TEXT("PeakUsedVirtual"), static_cast<double>(MemoryStats.PeakUsedVirtual)}
+	};
+	for (const TPair<FString, double>& Metric : Metrics)
+		UE_LOG(LogImportBenchmark, Display, TEXT("%s: %s"), *Metric.Key, *FString::SanitizeFloat(Metric.Value));
+
+	if (!WriteReport(ReportFile, InputFile, Metrics))
+	{
+		UE_LOG(LogImportBenchmark, Error, TEXT("Could not write the report to %s"), *ReportFile);
+		return 1;
+	}
+	UE_LOG(LogImportBenchmark, Display, TEXT("Wrote the report to %s"), *ReportFile);
+	return 0;
+}
+
+void UVRSSImportBenchmarkCommandlet::CreateTextures(const USimulationAsset* SimAsset)
+{
+	const TPair<FString, const TArray<FSoftObjectPath>*> AssetPaths[] = {
+		{"Obst", &SimAsset->Obstructions}, {"Slice", &SimAsset->Slices}, {"Volume", &SimAsset->Volumes}
+	};
+	for (const TPair<FString, const TArray<FSoftObjectPath>*>& TypePaths : AssetPaths)
+	{
+		// The atlas textures of the obstructions have already been created during the import
+		if (TypePaths.Key == "Obst" && SimAsset->ObstAtlasTextures.Num() > 0) continue;
+
+		for (const FSoftObjectPath& AssetPath : *TypePaths.Value)
+		{
+			const UFdsDataAsset* DataAsset = Cast<UFdsDataAsset>(AssetPath.TryLoad());
+			// Time series are streamed from their sidecar file and don't need any textures
+			if (!DataAsset || DataAsset->TimeSeries) continue;
+			FAssetCreationUtils::LoadTextures(DataAsset->DataInfo, TypePaths.Key);
+		}
+	}
+}
+
+bool UVRSSImportBenchmarkCommandlet::WriteReport(const FString& ReportFile, const FString& InputFile,
+                                                 const TArray<TPair<FString, double>>& Metrics)
+{
+	const FString Timestamp = FDateTime::UtcNow().ToIso8601();
+	if (FPaths::GetExtension(ReportFile).Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+	{
+		// Each run appends a row, so nightly runs can be compared with each other
+		FString Csv;
+		if (!FPaths::FileExists(ReportFile))
+		{
+			Csv = TEXT("Timestamp,Input");
+			for (const TPair<FString, double>& Metric : Metrics) Csv += "," + Metric.Key;
+			Csv += LINE_TERMINATOR;
+		}
+		Csv += Timestamp + ",\"" + InputFile.Replace(TEXT("\""), TEXT("\"\"")) + "\"";
+		for (const TPair<FString, double>& Metric : Metrics) Csv += "," + FString::SanitizeFloat(Metric.Value);
+		Csv += LINE_TERMINATOR;
+		return FFileHelper::SaveStringToFile(Csv, *ReportFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+		                                     &IFileManager::Get(), FILEWRITE_Append);
+	}
+
+	const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("Timestamp"), Timestamp);
+	Report->SetStringField(TEXT("Input"), InputFile);
+	for (const TPair<FString, double>& Metric : Metrics) Report->SetNumberField(Metric.Key, Metric.Value);
+
+	FString Json;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&Json));
+	return FFileHelper::SaveStringToFile(Json, *ReportFile);
+}
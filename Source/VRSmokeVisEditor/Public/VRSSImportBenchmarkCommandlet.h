@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "VRSSImportBenchmarkCommandlet.generated.h"
+
+
+DECLARE_LOG_CATEGORY_EXTERN(LogImportBenchmark, Log, All);
+
+/**
+ * Imports a simulation without any UI and writes the time spent in the different phases of the import as well as the
+ * peak memory usage into a report, so the import performance can be tracked over time. Usage:
+ * UnrealEditor-Cmd VRSmokeVis.uproject -run=VRSSImportBenchmark -Input=<[chid].smv|[chid]-smv.yaml>
+ *     [-Output=/Game/ImportBenchmark] [-Report=<File.json|File.csv>] [-CreateTextures] -nullrhi
+ * Instead of an input file, -Synthetic generates a simulation first, see FSyntheticDataSettings for its parameters.
+ */
+UCLASS()
+class UVRSSImportBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+	UVRSSImportBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer);
+
+public:
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	/** Creates the textures of all assets of the simulation, which are otherwise only created when first needed */
+	static void CreateTextures(const class USimulationAsset* SimAsset);
+
+	/** Writes the metrics as a single .json object or appends them as a row to a .csv file, depending on the extension
+	 * of the report file */
+	static bool WriteReport(const FString& ReportFile, const FString& InputFile,
+	                        const TArray<TPair<FString, double>>& Metrics);
+};
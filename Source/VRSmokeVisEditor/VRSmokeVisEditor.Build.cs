@@ -32,6 +32,7 @@ public class VRSmokeVisEditor : ModuleRules
                 "Engine",
                 "RHI",
                 "AssetRegistry",
+                "Json",
 				"HeadMountedDisplay",
 				"InputCore",
 				"VRSmokeVis"